@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    SpectrumKernelsBenchmark.cpp
+    Created: 16 Oct 2026 9:12:40am
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+// Console harness for the spectrum frame pipeline: ns per frame for FFT orders
+// 10..15, comparing the original scalar passes with SpectrumKernels.
+//
+// Only the stages around the transform are timed (unroll, mean removal, window
+// and magnitude); the FFT itself is the same juce::dsp::FFT either way.
+//
+// It needs nothing from JUCE beyond the headers, so it builds without the
+// plugin, from the project root with the generated JuceLibraryCode:
+//
+//   c++ -O2 -std=c++17 -DNDEBUG -IJuceLibraryCode -I<path to JUCE>/modules
+//       Benchmarks/SpectrumKernelsBenchmark.cpp Source/DSP/SpectrumKernels.cpp
+//       -o SpectrumKernelsBenchmark
+//
+// Pass the same architecture flags as the plugin build (e.g. -mavx2) to see the
+// kernels vectorised for that target.
+
+#include "../Source/DSP/SpectrumKernels.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    struct Buffers
+    {
+        explicit Buffers(int order)
+            : size(1 << order),
+            history((size_t)size),
+            window((size_t)size),
+            transform(2 * (size_t)size),
+            magnitude((size_t)size / 2)
+        {
+            for (int i = 0; i < size; ++i)
+            {
+                history[(size_t)i] = std::sin(0.01f * (float)i) + 0.1f;
+                window[(size_t)i] = 0.5f * (1.0f - std::cos(2.0f * 3.14159265f * (float)i / (float)(size - 1)));
+            }
+
+            // Interleaved re/im values for the magnitude stage; the FFT is not timed
+            for (size_t i = 0; i < transform.size(); ++i)
+                transform[i] = std::cos(0.003f * (float)i);
+        }
+
+        const int size;
+        const int writeIndex = size / 3;   // unroll from the middle, as a running history would
+        std::vector<float> history, window, transform, magnitude;
+    };
+
+    // The pipeline as it was before SpectrumKernels: four scalar passes with a
+    // modulo per sample, then a sqrt per bin
+    float runScalar(Buffers& b)
+    {
+        const int size = b.size;
+        std::vector<float>& data = b.transform;
+
+        for (int i = 0; i < size; ++i)
+            data[(size_t)i] = b.history[(size_t)((b.writeIndex + i) % size)];
+
+        float mean = 0.0f;
+        for (int i = 0; i < size; ++i)
+            mean += data[(size_t)i];
+        mean /= (float)size;
+
+        for (int i = 0; i < size; ++i)
+            data[(size_t)i] -= mean;
+
+        for (int i = 0; i < size; ++i)
+            data[(size_t)i] *= b.window[(size_t)i];
+
+        const int numBins = size / 2;
+        for (int bin = 1; bin < numBins; ++bin)
+        {
+            const float re = data[2 * (size_t)bin];
+            const float im = data[2 * (size_t)bin + 1];
+            b.magnitude[(size_t)bin] = 2.0f * std::sqrt(re * re + im * im) / ((float)size * 0.5f);
+        }
+
+        return b.magnitude[1];
+    }
+
+    // SpectrumAnalyzer::computeMonoFFT around the transform, with or without the sqrt
+    float runKernels(Buffers& b, bool power)
+    {
+        const int size = b.size;
+        const int numBins = size / 2;
+        const float scale = 2.0f / ((float)size * 0.5f);
+
+        const float mean = SpectrumKernels::mean(b.history.data(), size);
+        SpectrumKernels::unrollWindowed(b.transform.data(), b.history.data(), b.writeIndex, size, b.window.data(), mean);
+
+        SpectrumKernels::power(b.magnitude.data(), b.transform.data(), scale * scale, numBins);
+
+        if (!power)
+            SpectrumKernels::squareRoot(b.magnitude.data(), numBins);
+
+        return b.magnitude[1];
+    }
+
+    template <typename Function>
+    double nanosecondsPerFrame(int numFrames, Function&& runFrame)
+    {
+        volatile float sink = 0.0f;
+
+        // one untimed pass to warm the caches
+        sink = sink + runFrame();
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < numFrames; ++i)
+            sink = sink + runFrame();
+
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / numFrames;
+    }
+}
+
+int main()
+{
+    std::printf("order   size    scalar ns   kernels ns   kernels (power) ns   speed-up (power)\n");
+
+    for (int order = 10; order <= 15; ++order)
+    {
+        Buffers buffers(order);
+
+        // about 100M samples per measurement, whatever the size
+        const int numFrames = (100 << 20) >> order;
+
+        const double scalar = nanosecondsPerFrame(numFrames, [&] { return runScalar(buffers); });
+        const double linear = nanosecondsPerFrame(numFrames, [&] { return runKernels(buffers, false); });
+        const double power = nanosecondsPerFrame(numFrames, [&] { return runKernels(buffers, true); });
+
+        std::printf("%5d %6d %12.0f %12.0f %20.0f %17.1fx\n", order, 1 << order, scalar, linear, power, scalar / power);
+    }
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    AnalysisFramePool.h
+    Created: 15 Oct 2026 6:52:05pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "TripleBuffer.h"
+
+// Fixed set of reference-counted analysis frames, handed from one producer (the
+// audio thread or the analysis worker) to the GUI.
+//
+// The producer fills a free frame and publishes its pointer through a triple
+// buffer. A published frame is never written again while anyone still holds a
+// reference to it, so the GUI can pin a frame (freeze, snapshots) just by
+// keeping the pointer: no copy, no lock. The pool itself always keeps one
+// reference per frame, so nothing is ever freed on the producer thread, and
+// a frame counts as free once that is the only reference left.
+template <typename Data>
+class AnalysisFramePool
+{
+public:
+    struct Frame : Data, juce::ReferenceCountedObject
+    {
+        juce::int64 timestamp = 0; // samples since prepareToPlay, up to the end of what this frame covers
+    };
+
+    using Ptr = juce::ReferenceCountedObjectPtr<Frame>;
+
+    // The three exchange slots, one frame being written and the live view,
+    // plus maxPinnedFrames held by the GUI on top of that
+    static constexpr int maxPinnedFrames = 3;
+    static constexpr int defaultSize = 5 + maxPinnedFrames;
+
+    // Allocates every frame and puts initialised ones in the exchange, so
+    // getLatest() is never null. Call before either side is running.
+    template <typename Fn>
+    void initialise(Fn&& initialiseData, int numFrames = defaultSize)
+    {
+        frames.clear();
+
+        for (int i = 0; i < juce::jmax(numFrames, 4); ++i)
+        {
+            frames.emplace_back(new Frame());
+            initialiseData(static_cast<Data&>(*frames.back()));
+        }
+
+        int next = 0;
+        exchange.forEachBuffer([this, &next](Ptr& slot) { slot = frames[(size_t)next++]; });
+    }
+
+    // Producer side. Returns nullptr only if the GUI pins more frames than the
+    // pool was sized for; the producer should then skip this frame.
+    Frame* getFreeFrame() noexcept
+    {
+        for (auto& frame : frames)
+            if (frame->getReferenceCount() == 1)
+                return frame.get();
+
+        return nullptr;
+    }
+
+    void publish(Frame* frame, juce::int64 timestamp) noexcept
+    {
+        frame->timestamp = timestamp;
+        exchange.getWriteBuffer() = frame;
+        exchange.publish();
+    }
+
+    // Consumer side. Returns true if a newer frame was picked up.
+    bool acquire() noexcept { return exchange.acquire(); }
+
+    // Copy the pointer to pin the frame
+    const Ptr& getLatest() const noexcept { return exchange.getReadBuffer(); }
+
+private:
+    std::vector<Ptr> frames;
+    TripleBuffer<Ptr> exchange;
+};
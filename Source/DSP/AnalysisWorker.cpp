@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    AnalysisWorker.cpp
+    Created: 15 Oct 2026 10:12:04am
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#include "AnalysisWorker.h"
+
+AnalysisWorker::AnalysisWorker()
+    : juce::Thread("YAAA analysis")
+{
+}
+
+AnalysisWorker::~AnalysisWorker()
+{
+    stop();
+}
+
+void AnalysisWorker::addClient(Client* client)
+{
+    const juce::ScopedLock sl(clientLock);
+    clients.addIfNotAlreadyThere(client);
+}
+
+void AnalysisWorker::removeClient(Client* client)
+{
+    const juce::ScopedLock sl(clientLock);
+    clients.removeFirstMatchingValue(client);
+}
+
+void AnalysisWorker::start()
+{
+    startThread();
+}
+
+void AnalysisWorker::stop()
+{
+    stopThread(1000);
+}
+
+void AnalysisWorker::run()
+{
+    while (!threadShouldExit())
+    {
+        bool didWork = false;
+
+        {
+            const juce::ScopedLock sl(clientLock);
+            for (auto* client : clients)
+                didWork = client->serviceAnalysis() || didWork;
+        }
+
+        if (!didWork)
+            wait(pollIntervalMs);
+    }
+}
@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    AnalysisWorker.h
+    Created: 15 Oct 2026 10:12:04am
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Background thread that runs the expensive half of the analyzers (FFTs etc.)
+// so the audio callback only has to hand samples over through lock-free rings.
+//
+// Clients are polled in a loop: the audio thread never signals the worker, it
+// just writes into its ring and the worker picks the samples up on its next pass.
+class AnalysisWorker : private juce::Thread
+{
+public:
+    struct Client
+    {
+        virtual ~Client() = default;
+
+        // Called on the worker thread. Return true if any work was done so the
+        // worker polls again straight away instead of sleeping.
+        virtual bool serviceAnalysis() = 0;
+    };
+
+    AnalysisWorker();
+    ~AnalysisWorker() override;
+
+    // Message thread only
+    void addClient(Client* client);
+    void removeClient(Client* client);
+
+    void start();
+    void stop();
+
+private:
+    void run() override;
+
+    static constexpr int pollIntervalMs = 4;
+
+    juce::CriticalSection clientLock; // worker <-> message thread only
+    juce::Array<Client*> clients;
+};
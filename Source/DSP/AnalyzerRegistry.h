@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    AnalyzerRegistry.h
+    Created: 15 Oct 2026 10:31:06pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+
+// Which of the optional analysis engines somebody is looking at.
+//
+// Every consumer (the editor's current view, an export, ...) holds a Consumer
+// and declares the engines it reads. An engine runs while at least one
+// consumer wants it; the processor checks isActive() once per block and
+// switches the engine on or off. Loudness, true peak, correlation and the
+// history behind them are not listed here: they always run, because their
+// statistics have to cover everything that was played.
+class AnalyzerRegistry
+{
+public:
+    enum Analyzer
+    {
+        spectrum,                   // main FFT (spectrum, spectrogram, stereo spectrum)
+        multiResolutionSpectrum,
+        multibandCorrelation,
+        stereoScope,                // goniometer points
+        numAnalyzers
+    };
+
+    static constexpr juce::uint32 maskOf(Analyzer analyzer) noexcept { return 1u << (juce::uint32)analyzer; }
+
+    // Any thread
+    bool isActive(Analyzer analyzer) const noexcept { return numConsumers[analyzer].load(std::memory_order_relaxed) > 0; }
+
+    // Demand declared by one consumer; released when it goes away.
+    // Not thread-safe itself: each Consumer belongs to one thread (usually
+    // the message thread), only the counts it updates are shared.
+    class Consumer
+    {
+    public:
+        explicit Consumer(AnalyzerRegistry& owner, juce::uint32 initialDemand = 0) : registry(owner) { setDemand(initialDemand); }
+        ~Consumer() { setDemand(0); }
+
+        void setDemand(juce::uint32 newDemand) noexcept
+        {
+            for (int a = 0; a < numAnalyzers; ++a)
+            {
+                const auto mask = maskOf((Analyzer)a);
+
+                if ((newDemand & mask) != 0 && (demand & mask) == 0)
+                    registry.numConsumers[a].fetch_add(1, std::memory_order_relaxed);
+                else if ((newDemand & mask) == 0 && (demand & mask) != 0)
+                    registry.numConsumers[a].fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            demand = newDemand;
+        }
+
+        juce::uint32 getDemand() const noexcept { return demand; }
+
+    private:
+        AnalyzerRegistry& registry;
+        juce::uint32 demand = 0;
+
+        JUCE_DECLARE_NON_COPYABLE(Consumer)
+    };
+
+private:
+    std::atomic<int> numConsumers[numAnalyzers] = {};
+};
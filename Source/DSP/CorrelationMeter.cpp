@@ -12,48 +12,108 @@
 
 CorrelationMeter::CorrelationMeter()
 {
+    frames.initialise([](Frame&) {});
 }
 
 CorrelationMeter::~CorrelationMeter()
 {
 }
 
-void CorrelationMeter::prepareToPlay(int size)
+void CorrelationMeter::prepareToPlay(double sampleRate, double maxIntegrationMs)
 {
-    const juce::ScopedLock sl(lock);
-    bufferSize = size;
-    leftBuffer.calloc(bufferSize);
-    rightBuffer.calloc(bufferSize);
+    currentSampleRate = sampleRate;
+    bufferCapacity = juce::jmax(1, (int)std::ceil(sampleRate * maxIntegrationMs * 0.001));
+    leftBuffer.calloc(bufferCapacity);
+    rightBuffer.calloc(bufferCapacity);
+    samplesProcessed = 0;
+    negative = false;
+
+    appliedIntegrationMs = 0.0f;
+    applyIntegrationTime();
+}
+
+void CorrelationMeter::applyIntegrationTime()
+{
+    const float milliseconds = requestedIntegrationMs.load(std::memory_order_relaxed);
+    if (milliseconds == appliedIntegrationMs)
+        return;
+
+    appliedIntegrationMs = milliseconds;
+    windowSize = juce::jlimit(1, bufferCapacity, juce::roundToInt(currentSampleRate * milliseconds * 0.001));
+
+    // start again from an empty (silent) window
+    juce::FloatVectorOperations::clear(leftBuffer.get(), windowSize);
+    juce::FloatVectorOperations::clear(rightBuffer.get(), windowSize);
     fifoIndex = 0;
+    sumLR = sumL2 = sumR2 = 0.0;
+    freshLR = freshL2 = freshR2 = 0.0;
 }
 
-void CorrelationMeter::pushAudioBlock(const float* left, const float* right, int numSamples)
+StereoKernels::Sums CorrelationMeter::pushAudioBlock(const float* left, const float* right, int numSamples)
 {
-    const juce::ScopedLock sl(lock);
-    for (int i = 0; i < numSamples; ++i)
+    StereoKernels::Sums blockSums;
+
+    applyIntegrationTime();
+
+    // Runs end wherever the write index wraps
+    for (int start = 0; start < numSamples;)
     {
-        leftBuffer[fifoIndex] = left[i];
-        rightBuffer[fifoIndex] = right[i];
-        fifoIndex = (fifoIndex + 1) % bufferSize;
+        const int n = juce::jmin(numSamples - start, windowSize - fifoIndex);
+
+        StereoKernels::Sums outgoing;
+        const auto incoming = StereoKernels::measure(left + start, right + start, n,
+                                                     leftBuffer + fifoIndex, rightBuffer + fifoIndex, outgoing);
+        blockSums += incoming;
+
+        sumLR += incoming.lr - outgoing.lr;
+        sumL2 += incoming.ll - outgoing.ll;
+        sumR2 += incoming.rr - outgoing.rr;
+
+        freshLR += incoming.lr;
+        freshL2 += incoming.ll;
+        freshR2 += incoming.rr;
+
+        start += n;
+        fifoIndex += n;
+
+        // a full pass: the fresh sums now cover exactly the window
+        if (fifoIndex == windowSize)
+        {
+            fifoIndex = 0;
+            sumLR = freshLR;
+            sumL2 = freshL2;
+            sumR2 = freshR2;
+            freshLR = freshL2 = freshR2 = 0.0;
+        }
     }
-}
 
-float CorrelationMeter::getCorrelation() const
-{
-    const juce::ScopedLock sl(lock);
-    double sumLR = 0.0;
-    double sumL2 = 0.0;
-    double sumR2 = 0.0;
+    samplesProcessed += numSamples;
+    lastCorrelation = computeCorrelation();
 
-    for (int i = 0; i < bufferSize; ++i)
+    if (!negative ? lastCorrelation < 0.0f : lastCorrelation >= negativeClearLevel)
     {
-        sumLR += leftBuffer[i] * rightBuffer[i];
-        sumL2 += leftBuffer[i] * leftBuffer[i];
-        sumR2 += rightBuffer[i] * rightBuffer[i];
+        negative = !negative;
+
+        if (eventLog != nullptr)
+            eventLog->push(MeterEvent::Type::correlationNegative, negative, -1, lastCorrelation, numSamples - 1);
     }
 
-    if (sumL2 <= 0.0 || sumR2 <= 0.0)
+    if (auto* frame = frames.getFreeFrame())
+    {
+        frame->correlation = lastCorrelation;
+        frames.publish(frame, samplesProcessed);
+    }
+
+    return blockSums;
+}
+
+float CorrelationMeter::computeCorrelation() const
+{
+    // the subtracted sums can end up a hair off zero after silence
+    constexpr double silence = 1.0e-12;
+
+    if (sumL2 <= silence || sumR2 <= silence)
         return 0.0f; // avoid divide by zero
 
-    return static_cast<float>(sumLR / std::sqrt(sumL2 * sumR2));
+    return juce::jlimit(-1.0f, 1.0f, static_cast<float>(sumLR / std::sqrt(sumL2 * sumR2)));
 }
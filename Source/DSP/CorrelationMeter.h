@@ -10,21 +10,77 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include <atomic>
+#include "AnalysisFramePool.h"
+#include "MeterEventLog.h"
+#include "StereoKernels.h"
 
+// Sliding-window L/R correlation, O(1) per sample.
+//
+// Running sums of L*R, L^2 and R^2 are updated as runs of samples enter and
+// leave the window. A second set of sums is built over each pass through the
+// window and replaces the running ones when the write index wraps, so rounding
+// error never builds up beyond one window.
+//
+// With an event log attached, the correlation going negative is reported at
+// the end of the block where it happened; it clears again once it is back
+// above negativeClearLevel, so noise around zero doesn't flood the log.
 class CorrelationMeter
 {
 public:
+    struct Frame
+    {
+        float correlation = 0.0f; // -1 to +1 over the integration window
+    };
+
+    using FramePtr = AnalysisFramePool<Frame>::Ptr;
+
 	CorrelationMeter();
 	~CorrelationMeter();
 
-    void prepareToPlay(int bufferSize);
-    void pushAudioBlock(const float* left, const float* right, int numSamples);
-    float getCorrelation() const; // Returns -1 to +1
+    // Allocates the window for the longest integration time (not realtime safe)
+    void prepareToPlay(double sampleRate, double maxIntegrationMs);
+
+    // Any thread. Takes effect from the next block and restarts the window.
+    void setIntegrationTime(float milliseconds) noexcept { requestedIntegrationMs.store(milliseconds, std::memory_order_relaxed); }
+
+    // Call before processing starts; nullptr for no events
+    void setEventLog(MeterEventLog* log) noexcept { eventLog = log; }
+
+    // Audio thread: updates the window and publishes a frame per block. The
+    // block is measured in the same pass that writes it into the window; the
+    // result is the block's shared statistics for the other meters.
+    StereoKernels::Sums pushAudioBlock(const float* left, const float* right, int numSamples);
+
+    // GUI thread: picks up the newest frame (copy the pointer to pin it)
+    const FramePtr& acquireLatestFrame() noexcept { frames.acquire(); return frames.getLatest(); }
+
+    // Audio thread, after pushAudioBlock: the correlation the last frame carries
+    float getCorrelation() const noexcept { return lastCorrelation; }
 
 private:
+    void applyIntegrationTime();
+    float computeCorrelation() const;
+
     juce::HeapBlock<float> leftBuffer;
     juce::HeapBlock<float> rightBuffer;
     int fifoIndex = 0;
-    int bufferSize = 1024;
-    juce::CriticalSection lock;
+    int bufferCapacity = 1024;
+    int windowSize = 1024;
+    double currentSampleRate = 44100.0;
+
+    std::atomic<float> requestedIntegrationMs{ 300.0f };
+    float appliedIntegrationMs = 0.0f;
+
+    double sumLR = 0.0, sumL2 = 0.0, sumR2 = 0.0;        // over the window
+    double freshLR = 0.0, freshL2 = 0.0, freshR2 = 0.0;  // over the current pass
+
+    float lastCorrelation = 0.0f;
+
+    static constexpr float negativeClearLevel = 0.05f;
+    MeterEventLog* eventLog = nullptr;
+    bool negative = false;
+
+    AnalysisFramePool<Frame> frames;
+    juce::int64 samplesProcessed = 0;
 };
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    GoniometerImage.cpp
+    Created: 15 Oct 2026 7:48:20pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#include "GoniometerImage.h"
+
+GoniometerImage::GoniometerImage()
+    : density((size_t)(resolution * resolution), 0.0f),
+    image(juce::Image::ARGB, resolution, resolution, true)
+{
+    // log-compressed: transparent -> deep sky blue -> white
+    for (int i = 0; i < lutSize; ++i)
+    {
+        const float position = (float)i / (float)(lutSize - 1);
+        const auto colour = position < 0.7f
+            ? juce::Colours::deepskyblue.withAlpha(position / 0.7f)
+            : juce::Colours::deepskyblue.interpolatedWith(juce::Colours::white, (position - 0.7f) / 0.3f);
+
+        colourLut[(size_t)i] = colour.getPixelARGB();
+    }
+}
+
+void GoniometerImage::update(StereoScopeTap& tap, double nowMs)
+{
+    if (lastUpdateMs > 0.0)
+    {
+        const double elapsedSeconds = (nowMs - lastUpdateMs) * 0.001;
+        const float decay = (float)std::exp(-elapsedSeconds / persistenceSeconds);
+        juce::FloatVectorOperations::multiply(density.data(), decay, (int)density.size());
+    }
+
+    lastUpdateMs = nowMs;
+
+    tap.read([this](const float* const* midSide, int numPoints)
+        {
+            addPoints(midSide[StereoScopeTap::mid], midSide[StereoScopeTap::side], numPoints);
+        });
+
+    imageDirty = true;
+}
+
+void GoniometerImage::addPoints(const float* mid, const float* side, int numPoints) noexcept
+{
+    // +-1 spans the grid; overs are clamped to the border rather than dropped
+    const float scale = (float)resolution * 0.5f;
+    const float centre = (float)resolution * 0.5f;
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const int x = juce::jlimit(0, resolution - 1, (int)std::floor(centre + side[i] * scale));
+        const int y = juce::jlimit(0, resolution - 1, (int)std::floor(centre - mid[i] * scale));
+
+        density[(size_t)(y * resolution + x)] += 1.0f;
+    }
+}
+
+void GoniometerImage::renderImage()
+{
+    juce::Image::BitmapData bitmap(image, juce::Image::BitmapData::writeOnly);
+
+    const float lutScale = (float)(lutSize - 1) / std::log1p(densityForFullScale);
+
+    for (int y = 0; y < resolution; ++y)
+    {
+        const float* row = density.data() + (size_t)(y * resolution);
+
+        for (int x = 0; x < resolution; ++x)
+        {
+            const int index = juce::jmin(lutSize - 1, (int)(std::log1p(row[x]) * lutScale));
+            *reinterpret_cast<juce::PixelARGB*>(bitmap.getPixelPointer(x, y)) = colourLut[(size_t)index];
+        }
+    }
+
+    imageDirty = false;
+}
+
+void GoniometerImage::draw(juce::Graphics& g, juce::Rectangle<float> area)
+{
+    if (imageDirty)
+        renderImage();
+
+    g.drawImage(image, area);
+}
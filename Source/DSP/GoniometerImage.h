@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    GoniometerImage.h
+    Created: 15 Oct 2026 7:48:20pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "StereoScopeTap.h"
+
+// Mid/side phase cloud as a fixed-size density histogram (GUI thread only).
+//
+// Every point from the tap adds to one cell, and the whole grid decays with a
+// time constant, which gives the persistence. The grid is turned into an image
+// through a colour table only when it is drawn, so the paint cost is one
+// resolution x resolution pass plus one blit however many points came in.
+class GoniometerImage
+{
+public:
+    static constexpr int resolution = 256;
+    static constexpr double persistenceSeconds = 0.25;
+
+    GoniometerImage();
+
+    // Drains the tap and applies the decay for the time since the last call
+    void update(StereoScopeTap& tap, double nowMs);
+
+    // Side runs left to right and mid bottom to top, with M = (L + R) / 2 and
+    // S = (L - R) / 2. |M| or |S| = 1 (both channels at 0 dBFS, in or out of
+    // phase) reaches the edge of the area, so the inscribed diamond is where
+    // the louder channel hits 0 dBFS. Anything beyond is piled up on the border.
+    void draw(juce::Graphics& g, juce::Rectangle<float> area);
+
+private:
+    void addPoints(const float* mid, const float* side, int numPoints) noexcept;
+    void renderImage();
+
+    static constexpr int lutSize = 256;
+    static constexpr float densityForFullScale = 256.0f; // hits per cell that map to the top of the table
+
+    std::array<juce::PixelARGB, lutSize> colourLut;
+    std::vector<float> density;     // resolution * resolution, row 0 at the top
+    juce::Image image;
+    bool imageDirty = true;
+    double lastUpdateMs = 0.0;
+};
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    HalfBandDecimator.cpp
+    Created: 15 Oct 2026 2:58:30pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#include "HalfBandDecimator.h"
+
+HalfBandDecimator::HalfBandDecimator()
+{
+    // h[m] = sin(pi m / 2) / (pi m) * w[m], m = tap - centre; zero for even m != 0
+    double sum = 0.5;
+    std::array<double, numSideTaps> taps{};
+
+    for (int j = 0; j < numSideTaps; ++j)
+    {
+        const int m = 2 * j + 1;
+        const double n = (double)(centreTap + m) / (double)(numTaps - 1);
+        const double window = 0.42 - 0.5 * std::cos(2.0 * juce::MathConstants<double>::pi * n)
+                                   + 0.08 * std::cos(4.0 * juce::MathConstants<double>::pi * n);
+        const double sinc = std::sin(juce::MathConstants<double>::pi * m * 0.5) / (juce::MathConstants<double>::pi * m);
+
+        taps[j] = sinc * window;
+        sum += 2.0 * taps[j];
+    }
+
+    // unity gain at DC; the centre tap stays at 0.5 after normalising
+    for (int j = 0; j < numSideTaps; ++j)
+        sideTaps[j] = (float)(taps[j] * 0.5 / (sum - 0.5));
+
+    reset();
+}
+
+void HalfBandDecimator::reset() noexcept
+{
+    history.fill(0.0f);
+    writePos = 0;
+    outputPhase = false;
+}
+
+int HalfBandDecimator::process(const float* input, float* output, int numInputSamples) noexcept
+{
+    int numOut = 0;
+
+    for (int i = 0; i < numInputSamples; ++i)
+    {
+        // newest sample at history[writePos], older ones at increasing offsets
+        writePos = (writePos == 0 ? numTaps : writePos) - 1;
+        history[writePos] = history[writePos + numTaps] = input[i];
+
+        outputPhase = !outputPhase;
+        if (!outputPhase)
+            continue;
+
+        const float* x = history.data() + writePos;
+        float acc = 0.5f * x[centreTap];
+
+        for (int j = 0; j < numSideTaps; ++j)
+        {
+            const int offset = 2 * j + 1;
+            acc += sideTaps[j] * (x[centreTap - offset] + x[centreTap + offset]);
+        }
+
+        output[numOut++] = acc;
+    }
+
+    return numOut;
+}
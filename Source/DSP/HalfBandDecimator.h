@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+    HalfBandDecimator.h
+    Created: 15 Oct 2026 2:58:30pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+
+// Decimate-by-2 with a linear-phase half-band FIR (Blackman-windowed sinc).
+// Every other tap of a half-band filter is zero, so only the centre tap and the
+// odd-offset taps are evaluated, and only for the samples that are kept.
+//
+// The passband is flat (within 0.05 dB) up to 0.8 of the new Nyquist and
+// anything that would alias into that range is attenuated by more than 75 dB.
+class HalfBandDecimator
+{
+public:
+    HalfBandDecimator();
+
+    void reset() noexcept;
+
+    // Consumes numInputSamples (odd counts are fine, the phase is carried over)
+    // and returns the number of samples written to output.
+    int process(const float* input, float* output, int numInputSamples) noexcept;
+
+    static constexpr int numTaps = 63;
+    static constexpr int centreTap = numTaps / 2;
+
+private:
+    static constexpr int numSideTaps = (centreTap + 1) / 2; // odd offsets 1, 3, ... centreTap
+
+    std::array<float, numSideTaps> sideTaps{};
+    std::array<float, 2 * numTaps> history{}; // each sample written twice so reads never wrap
+    int writePos = 0;
+    bool outputPhase = false;
+};
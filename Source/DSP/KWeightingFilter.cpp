@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+    KWeightingFilter.cpp
+    Created: 15 Oct 2026 9:41:08pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#include "KWeightingFilter.h"
+
+namespace
+{
+    // Normalised by a0
+    void setSection(float& b0, float& b1, float& b2, float& a1, float& a2,
+                    double c0, double c1, double c2, double d0, double d1, double d2)
+    {
+        b0 = (float)(c0 / d0);
+        b1 = (float)(c1 / d0);
+        b2 = (float)(c2 / d0);
+        a1 = (float)(d1 / d0);
+        a2 = (float)(d2 / d0);
+    }
+}
+
+void KWeightingFilter::prepare(double sampleRate, int channels)
+{
+    numChannels = juce::jlimit(0, maxChannels, channels);
+    numGroups = (numChannels + laneWidth - 1) / laneWidth;
+
+    // Designed for any sample rate from the analogue prototypes of the
+    // 48 kHz reference coefficients
+    {
+        const double f0 = 1681.974450955533;
+        const double gainDb = 3.999843853973347;
+        const double q = 0.7071752369554196;
+
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double vh = std::pow(10.0, gainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+
+        auto& s = sections[0];
+        setSection(s.b0, s.b1, s.b2, s.a1, s.a2,
+                   vh + vb * k / q + k * k, 2.0 * (k * k - vh), vh - vb * k / q + k * k,
+                   1.0 + k / q + k * k, 2.0 * (k * k - 1.0), 1.0 - k / q + k * k);
+    }
+
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+
+        // BS.1770 keeps the RLB numerator at {1, -2, 1}; only the feedback
+        // terms are normalised, or the whole curve sits 0.04 dB low
+        const double d0 = 1.0 + k / q + k * k;
+
+        auto& s = sections[1];
+        s.b0 = 1.0f;
+        s.b1 = -2.0f;
+        s.b2 = 1.0f;
+        s.a1 = (float)(2.0 * (k * k - 1.0) / d0);
+        s.a2 = (float)((1.0 - k / q + k * k) / d0);
+    }
+
+    reset();
+}
+
+void KWeightingFilter::reset() noexcept
+{
+    for (auto& s : state)
+    {
+        std::fill(std::begin(s.z1), std::end(s.z1), 0.0f);
+        std::fill(std::begin(s.z2), std::end(s.z2), 0.0f);
+    }
+}
+
+void KWeightingFilter::process(const float* const* channels, int numSamples, double* sumsOfSquares) noexcept
+{
+    const int numLanes = numGroups * laneWidth;
+
+    // unused lanes of the last group filter silence
+    alignas(32) float x[maxChannels] = {};
+    alignas(32) double sums[maxChannels] = {};
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            x[ch] = channels[ch][i];
+
+        // Transposed direct form II; the inner loops are over one group of lanes
+        for (int s = 0; s < numSections; ++s)
+        {
+            const auto c = sections[s];
+            auto& z = state[s];
+
+            for (int group = 0; group < numLanes; group += laneWidth)
+            {
+                for (int lane = group; lane < group + laneWidth; ++lane)
+                {
+                    const float y = c.b0 * x[lane] + z.z1[lane];
+                    z.z1[lane] = c.b1 * x[lane] - c.a1 * y + z.z2[lane];
+                    z.z2[lane] = c.b2 * x[lane] - c.a2 * y;
+                    x[lane] = y;
+                }
+            }
+        }
+
+        for (int group = 0; group < numLanes; group += laneWidth)
+            for (int lane = group; lane < group + laneWidth; ++lane)
+                sums[lane] += (double)x[lane] * x[lane];
+    }
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        sumsOfSquares[ch] += sums[ch];
+}
@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    KWeightingFilter.h
+    Created: 15 Oct 2026 9:41:08pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// ITU-R BS.1770-4 K-weighting (pre-filter shelf, then RLB high-pass) for up to
+// maxChannels channels at once.
+//
+// Every channel uses the same coefficients, so the filter state is stored one
+// array per state variable with a lane per channel, and the two biquads run
+// over groups of laneWidth channels. Each group loop is a few SIMD operations,
+// so 12 channels cost three groups rather than twelve filter calls per
+// sample. All state is fixed size: nothing is allocated after construction.
+class KWeightingFilter
+{
+public:
+    static constexpr int laneWidth = 4;
+    static constexpr int maxChannels = 16;
+
+    void prepare(double sampleRate, int numChannels);
+    void reset() noexcept;
+
+    // Filters numSamples of each channel and adds the sum of squares of the
+    // K-weighted output of channel ch to sumsOfSquares[ch]
+    void process(const float* const* channels, int numSamples, double* sumsOfSquares) noexcept;
+
+private:
+    struct Coefficients
+    {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+    };
+
+    // Structure of arrays: one lane per channel
+    struct StateLanes
+    {
+        alignas(32) float z1[maxChannels];
+        alignas(32) float z2[maxChannels];
+    };
+
+    static constexpr int numSections = 2;
+
+    Coefficients sections[numSections];
+    StateLanes state[numSections];
+
+    int numChannels = 0;
+    int numGroups = 0;
+};
@@ -12,62 +12,90 @@
 
 #include "LevelMeter.h"
 #include <cmath>
-#include <atomic>
 
 LevelMeter::LevelMeter()
 {
-    integratedLufs.store(std::numeric_limits<float>::quiet_NaN());
-    integratedValid.store(false);
-    lastBlockLufs.store(std::numeric_limits<float>::quiet_NaN());
-}
+    momentaryLufs = std::numeric_limits<float>::quiet_NaN();
+    shortTermLufs = std::numeric_limits<float>::quiet_NaN();
+    clearStatistics();
 
-double LevelMeter::powerToLufs(double power)
-{
-    // small epsilon to avoid -inf
-    return -0.691 + 10.0 * std::log10(power + 1e-12);
+    frames.initialise([](Frame&) {});
 }
 
-void LevelMeter::prepare(double sr, int channels)
+void LevelMeter::prepare(double sr, const juce::AudioChannelSet& layout)
 {
     sampleRate = sr > 0.0 ? sr : 44100.0;
-    numChannels = std::max(1, channels);
+    numChannels = juce::jlimit(1, KWeightingFilter::maxChannels, layout.size());
 
-    blockSize = static_cast<int>(std::round(0.400 * sampleRate)); // 400 ms blocks (example)
-    if (blockSize < 1) blockSize = 1;
+    stepSize = std::max(1, static_cast<int>(std::round(0.100 * sampleRate)));
 
-    hpFilters.clear();
-    shelfFilters.clear();
-    hpFilters.resize(numChannels);
-    shelfFilters.resize(numChannels);
+    kWeighting.prepare(sampleRate, numChannels);
+    silence.assign((size_t)stepSize, 0.0f);
 
+    channelWeights.fill(0.0);
     for (int ch = 0; ch < numChannels; ++ch)
-    {
-        hpFilters[ch].setCoefficients(
-            juce::IIRCoefficients::makeHighPass(sampleRate, 40.0, 0.70710678));
-
-        const double gainDb = 4.0;
-        shelfFilters[ch].setCoefficients(
-            juce::IIRCoefficients::makeHighShelf(sampleRate, 4000.0, 0.70710678, juce::Decibels::decibelsToGain(gainDb)));
-    }
+        channelWeights[(size_t)ch] = layout.isDisabled() ? 1.0 : getChannelWeight(layout.getTypeOfChannel(ch));
 
     reset();
 }
 
+double LevelMeter::getChannelWeight(juce::AudioChannelSet::ChannelType type) noexcept
+{
+    // BS.1770-4 Table 3: +1.5 dB for channels 60 to 120 degrees off centre
+    // (below 30 degrees elevation), none for LFE, 1 for everything else
+    switch (type)
+    {
+        case juce::AudioChannelSet::LFE:
+        case juce::AudioChannelSet::LFE2:
+            return 0.0;
+
+        case juce::AudioChannelSet::leftSurround:
+        case juce::AudioChannelSet::rightSurround:
+        case juce::AudioChannelSet::leftSurroundSide:
+        case juce::AudioChannelSet::rightSurroundSide:
+        case juce::AudioChannelSet::wideLeft:
+        case juce::AudioChannelSet::wideRight:
+            return 1.41;
+
+        default:
+            return 1.0;
+    }
+}
+
 void LevelMeter::reset()
 {
-    blockCounter = 0;
-    blockEnergy = 0.0;
-    accumulatedEnergy = 0.0;
-    accumulatedTime = 0.0;
-    integratedLufs.store(std::numeric_limits<float>::quiet_NaN());
-    integratedValid.store(false);
-    lastBlockLufs.store(std::numeric_limits<float>::quiet_NaN());
-
-    for (auto& f : hpFilters) f.reset();
-    for (auto& f : shelfFilters) f.reset();
+    stepCounter = 0;
+    stepEnergy = 0.0;
+    stepPower.fill(0.0);
+    stepWriteIndex = 0;
+    stepsFinished = 0;
+    aboveTarget = false;
+
+    momentaryLufs = std::numeric_limits<float>::quiet_NaN();
+    shortTermLufs = std::numeric_limits<float>::quiet_NaN();
+    clearStatistics();
+    statisticsResetRequested.store(false, std::memory_order_relaxed);
+    samplesProcessed = 0;
+
+    kWeighting.reset();
 }
 
-void LevelMeter::processBuffer(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+void LevelMeter::clearStatistics()
+{
+    histogram.reset();
+    shortTermHistogram.reset();
+
+    integratedLufs = std::numeric_limits<float>::quiet_NaN();
+    integratedValid = false;
+    loudnessRange = std::numeric_limits<float>::quiet_NaN();
+    rangeLowLufs = std::numeric_limits<float>::quiet_NaN();
+    rangeHighLufs = std::numeric_limits<float>::quiet_NaN();
+    shortTermMinLufs = std::numeric_limits<float>::quiet_NaN();
+    shortTermMaxLufs = std::numeric_limits<float>::quiet_NaN();
+}
+
+void LevelMeter::processBuffer(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples,
+                               const StereoKernels::Sums& stereoSums)
 {
     const int available = buffer.getNumSamples();
     if (startSample < 0) startSample = 0;
@@ -75,111 +103,131 @@ void LevelMeter::processBuffer(const juce::AudioBuffer<float>& buffer, int start
         numSamples = available - startSample;
     if (numSamples <= 0) return;
 
-    std::vector<const float*> chPtrs(numChannels, nullptr);
-    for (int ch = 0; ch < numChannels; ++ch)
-        chPtrs[ch] = (ch < buffer.getNumChannels()) ? buffer.getReadPointer(ch) + startSample : nullptr;
+    if (statisticsResetRequested.exchange(false, std::memory_order_relaxed))
+        clearStatistics();
 
-    std::vector<double> rmsSums(numChannels, 0.0);
+    // Missing channels are measured as silence
+    const int channelsPresent = std::min(numChannels, buffer.getNumChannels());
+    const float* channels[KWeightingFilter::maxChannels];
+    double sumsOfSquares[KWeightingFilter::maxChannels];
 
-    for (int i = 0; i < numSamples; ++i)
+    // Split at step boundaries; every run filters all channels together
+    for (int start = 0; start < numSamples;)
     {
-        double samplePower = 0.0;
+        const int n = std::min(numSamples - start, stepSize - stepCounter);
 
         for (int ch = 0; ch < numChannels; ++ch)
         {
-            float in = chPtrs[ch] ? chPtrs[ch][i] : 0.0f;
+            channels[ch] = ch < channelsPresent ? buffer.getReadPointer(ch, startSample + start) : silence.data();
+            sumsOfSquares[ch] = 0.0;
+        }
 
-            float filtered = hpFilters[ch].processSingleSampleRaw(in);
-            filtered = shelfFilters[ch].processSingleSampleRaw(filtered);
+        kWeighting.process(channels, n, sumsOfSquares);
 
-            const double p = filtered * filtered;
-            samplePower += p;
-            rmsSums[ch] += p;
-        }
+        for (int ch = 0; ch < numChannels; ++ch)
+            stepEnergy += channelWeights[(size_t)ch] * sumsOfSquares[ch];
 
-        samplePower /= static_cast<double>(numChannels);
-        blockEnergy += samplePower;
-        blockCounter++;
+        stepCounter += n;
+        start += n;
 
-        if (blockCounter >= blockSize)
-            finalizeBlock();
+        if (stepCounter >= stepSize)
+            finishStep(startSample + start - 1);
     }
 
-    // Update per-channel RMS and scale for visibility
+    samplesProcessed += numSamples;
+
+    auto* frame = frames.getFreeFrame();
+    if (frame == nullptr)
+        return;
+
+    // Per-channel RMS, scaled for visibility
     constexpr float displayScale = 10.0f; // increase visual response
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        float rms = static_cast<float>(std::sqrt(rmsSums[ch] / numSamples));
-        rms *= displayScale;                // scale RMS for visual feedback
-        rms = juce::jlimit(0.0f, 1.0f, rms); // clamp 0–1
-
-        if (ch == 0)
-            lastBlockRmsL.store(rms);
-        else if (ch == 1)
-            lastBlockRmsR.store(rms);
-    }
+    auto displayRms = [numSamples](double sumOfSquares)
+        {
+            const float rms = static_cast<float>(std::sqrt(sumOfSquares / numSamples)) * displayScale;
+            return juce::jlimit(0.0f, 1.0f, rms); // clamp 0–1
+        };
+
+    frame->rmsL = displayRms(stereoSums.ll);
+    frame->rmsR = displayRms(stereoSums.rr);
+    frame->peakL = stereoSums.peakL;
+    frame->peakR = stereoSums.peakR;
+
+    frame->momentaryLufs = momentaryLufs;
+    frame->shortTermLufs = shortTermLufs;
+    frame->integratedLufs = integratedLufs;
+    frame->integratedValid = integratedValid;
+    frame->loudnessRange = loudnessRange;
+    frame->rangeLowLufs = rangeLowLufs;
+    frame->rangeHighLufs = rangeHighLufs;
+    frame->shortTermMinLufs = shortTermMinLufs;
+    frame->shortTermMaxLufs = shortTermMaxLufs;
+    frames.publish(frame, samplesProcessed);
 }
 
-
-void LevelMeter::finalizeBlock()
+double LevelMeter::meanOfLastSteps(int count) const noexcept
 {
-    if (blockCounter <= 0) return;
+    double sum = 0.0;
+    for (int i = 1; i <= count; ++i)
+        sum += stepPower[(size_t)((stepWriteIndex - i + stepsPerShortTerm) % stepsPerShortTerm)];
 
-    const double meanPower = blockEnergy / static_cast<double>(blockCounter);
-    const double blockDuration = static_cast<double>(blockCounter) / sampleRate;
-    const double blockLufs = powerToLufs(meanPower);
+    return sum / count;
+}
+
+void LevelMeter::finishStep(int bufferOffset)
+{
+    stepPower[(size_t)stepWriteIndex] = stepEnergy / stepSize;
+    stepWriteIndex = (stepWriteIndex + 1) % stepsPerShortTerm;
+    stepsFinished = std::min(stepsFinished + 1, stepsPerShortTerm);
 
-    // Always store last block value for immediate GUI feedback
-    lastBlockLufs.store(static_cast<float>(blockLufs), std::memory_order_relaxed);
+    stepCounter = 0;
+    stepEnergy = 0.0;
 
-    // Absolute gate
-    if (blockLufs > absoluteGate)
+    // Every momentary block is also a gating block (400 ms, 75% overlap)
+    if (stepsFinished >= stepsPerMomentary)
     {
-        bool includeBlock = false;
+        const double power = meanOfLastSteps(stepsPerMomentary);
+        momentaryLufs = static_cast<float>(LoudnessHistogram::powerToLoudness(power));
+        histogram.add(power);
+    }
 
-        if (!integratedValid.load(std::memory_order_acquire))
-        {
-            includeBlock = true; // seed
-        }
-        else
-        {
-            const double runningMeanPower = accumulatedEnergy / std::max(accumulatedTime, 1e-12);
-            const double runningLufs = powerToLufs(runningMeanPower);
-            const double relativeGateThreshold = runningLufs - 10.0;
-            if (blockLufs > relativeGateThreshold)
-                includeBlock = true;
-        }
+    if (stepsFinished >= stepsPerShortTerm)
+    {
+        const double power = meanOfLastSteps(stepsPerShortTerm);
+        shortTermLufs = static_cast<float>(LoudnessHistogram::powerToLoudness(power));
+        shortTermHistogram.add(power);
+        updateRangeStatistics();
 
-        if (includeBlock)
+        const float target = loudnessTarget.load(std::memory_order_relaxed);
+        if ((shortTermLufs > target) != aboveTarget)
         {
-            accumulatedEnergy += meanPower * blockDuration;
-            accumulatedTime += blockDuration;
-
-            const double integratedMeanPower = accumulatedEnergy / std::max(accumulatedTime, 1e-12);
-            const double integrated = powerToLufs(integratedMeanPower);
+            aboveTarget = !aboveTarget;
 
-            integratedLufs.store(static_cast<float>(integrated), std::memory_order_release);
-            integratedValid.store(true, std::memory_order_release);
+            if (eventLog != nullptr)
+                eventLog->push(MeterEvent::Type::shortTermAboveTarget, aboveTarget, -1, shortTermLufs, bufferOffset);
         }
     }
 
-    // reset block accumulators
-    blockCounter = 0;
-    blockEnergy = 0.0;
+    const double gatedPower = histogram.getGatedPower(relativeGate);
+    if (gatedPower > 0.0)
+    {
+        integratedLufs = static_cast<float>(LoudnessHistogram::powerToLoudness(gatedPower));
+        integratedValid = true;
+    }
 }
 
-float LevelMeter::getIntegratedLufs() const noexcept
+void LevelMeter::updateRangeStatistics()
 {
-    return integratedLufs.load(std::memory_order_acquire);
-}
+    if (shortTermHistogram.getNumBlocks() == 0)
+        return;
 
-bool LevelMeter::hasIntegratedLufs() const noexcept
-{
-    return integratedValid.load(std::memory_order_acquire);
-}
+    // Tech 3342: short-term values 20 LU below their power mean don't count
+    const double gate = LoudnessHistogram::powerToLoudness(shortTermHistogram.getMeanPower()) + rangeGate;
 
-float LevelMeter::getLastBlockLufs() const noexcept
-{
-    return lastBlockLufs.load(std::memory_order_relaxed);
-}
+    rangeLowLufs = static_cast<float>(shortTermHistogram.getPercentile(rangeLowPercentile, gate));
+    rangeHighLufs = static_cast<float>(shortTermHistogram.getPercentile(rangeHighPercentile, gate));
+    loudnessRange = rangeHighLufs - rangeLowLufs;
 
+    shortTermMinLufs = static_cast<float>(shortTermHistogram.getPercentile(0.0));
+    shortTermMaxLufs = static_cast<float>(shortTermHistogram.getPercentile(1.0));
+}
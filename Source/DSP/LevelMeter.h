@@ -10,61 +10,129 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include <array>
 #include <atomic>
-
-// Simple approximate LUFS meter: K-weighting (HP + shelf), block-based mean-power,
-// absolute gate, single-pass relative gating approximation, exposes integrated LUFS
-// and last-block LUFS for immediate GUI display.
+#include "AnalysisFramePool.h"
+#include "KWeightingFilter.h"
+#include "LoudnessHistogram.h"
+#include "MeterEventLog.h"
+#include "StereoKernels.h"
+
+// ITU-R BS.1770-4 loudness: momentary (400 ms), short-term (3 s) and gated
+// integrated loudness, plus the EBU Tech 3342 loudness range.
+//
+// The K-weighted, channel-weighted power is summed over 100 ms steps; the last
+// 30 steps sit in a small ring, so the momentary and short-term windows (and
+// the 75% overlap of the gating blocks) are exact sums of whole steps, updated
+// every 100 ms. Every momentary block goes into a LoudnessHistogram, which
+// answers the two-pass relative gate in O(bins) with constant memory; every
+// short-term value goes into a second one for the loudness range and the
+// short-term statistics. Channels are K-weighted together (KWeightingFilter)
+// and summed with the BS.1770 weights of their position in the layout.
 //
-// This implementation is intentionally pragmatic and single-pass (not the strict two-pass BS.1770).
+// With an event log attached, the short-term loudness crossing the loudness
+// target is reported at the last sample of the step that crossed it.
 class LevelMeter
 {
 public:
+    // Published once per processed buffer
+    struct Frame
+    {
+        float momentaryLufs = std::numeric_limits<float>::quiet_NaN();  // NaN until 400 ms have been measured
+        float shortTermLufs = std::numeric_limits<float>::quiet_NaN();  // NaN until 3 s have been measured
+        float integratedLufs = std::numeric_limits<float>::quiet_NaN();
+        bool integratedValid = false;   // at least one block passed the gates
+        float loudnessRange = std::numeric_limits<float>::quiet_NaN();   // LU, rangeHighLufs - rangeLowLufs
+        float rangeLowLufs = std::numeric_limits<float>::quiet_NaN();    // 10th percentile of gated short-term
+        float rangeHighLufs = std::numeric_limits<float>::quiet_NaN();   // 95th percentile of gated short-term
+        float shortTermMinLufs = std::numeric_limits<float>::quiet_NaN(); // above the absolute gate
+        float shortTermMaxLufs = std::numeric_limits<float>::quiet_NaN();
+        float rmsL = 0.0f;  // display-scaled 0..1
+        float rmsR = 0.0f;
+        float peakL = 0.0f; // sample peak of the buffer, linear
+        float peakR = 0.0f;
+    };
+
+    using FramePtr = AnalysisFramePool<Frame>::Ptr;
+
     LevelMeter();
     ~LevelMeter() = default;
 
-    void prepare(double sampleRate, int channels);
+    // Channels beyond KWeightingFilter::maxChannels are not measured
+    void prepare(double sampleRate, const juce::AudioChannelSet& layout);
     void reset();
 
-    // Process a buffer range (audio thread)
-    void processBuffer(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+    // Any thread. Integrated loudness, loudness range and the short-term
+    // statistics start again from the next buffer; the windows keep running.
+    void resetStatistics() noexcept { statisticsResetRequested.store(true, std::memory_order_relaxed); }
 
-    float getIntegratedLufs() const noexcept;
-    bool hasIntegratedLufs() const noexcept;
+    // Call before processing starts; nullptr for no events
+    void setEventLog(MeterEventLog* log) noexcept { eventLog = log; }
 
-    // immediate fallback so GUI shows something quickly
-    float getLastBlockLufs() const noexcept;
+    // Any thread. Short-term loudness above this is reported as an overshoot.
+    void setLoudnessTarget(float lufs) noexcept { loudnessTarget.store(lufs, std::memory_order_relaxed); }
 
-    std::atomic<float> lastBlockRmsL{ 0.0f };
-    std::atomic<float> lastBlockRmsR{ 0.0f };
-
-private:
-    void finalizeBlock();
+    // Process a buffer range (audio thread). The L/R RMS and peaks come from
+    // the range's shared statistics (StereoKernels::measure).
+    void processBuffer(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples,
+                       const StereoKernels::Sums& stereoSums);
 
-    // converts power to LUFS (small epsilon to avoid log(0))
-    static double powerToLufs(double power);
+    // GUI thread: picks up the newest frame (copy the pointer to pin it)
+    const FramePtr& acquireLatestFrame() noexcept { frames.acquire(); return frames.getLatest(); }
 
-    double sampleRate = 44100.0;
-    int numChannels = 2;
+    // Audio thread, after processBuffer: what the last frame carries
+    float getMomentaryLufs() const noexcept { return momentaryLufs; }
+    float getShortTermLufs() const noexcept { return shortTermLufs; }
 
-    // block accumulation
-    int blockSize = 1024; // in samples
-    int blockCounter = 0;
-    double blockEnergy = 0.0;
+private:
+    static double getChannelWeight(juce::AudioChannelSet::ChannelType type) noexcept;
 
-    // accumulated gated energy/time (for integrated)
-    double accumulatedEnergy = 0.0;
-    double accumulatedTime = 0.0;
+    void finishStep(int bufferOffset);
+    void updateRangeStatistics();
+    void clearStatistics();
+    double meanOfLastSteps(int count) const noexcept;
 
-    // filters for K-weighting per channel
-    std::vector<juce::IIRFilter> hpFilters;
-    std::vector<juce::IIRFilter> shelfFilters;
+    static constexpr int stepsPerMomentary = 4;     // 400 ms
+    static constexpr int stepsPerShortTerm = 30;    // 3 s
+    static constexpr double relativeGate = -10.0;   // LU
+    static constexpr double rangeGate = -20.0;      // LU, Tech 3342
+    static constexpr double rangeLowPercentile = 0.10;
+    static constexpr double rangeHighPercentile = 0.95;
 
-    // gating params (tunable)
-    double absoluteGate = -70.0; // LUFS
-    // atomic shared outputs
-    std::atomic<float> integratedLufs;
-    std::atomic<bool> integratedValid;
-    std::atomic<float> lastBlockLufs;
+    double sampleRate = 44100.0;
+    int numChannels = 2;
 
-};
\ No newline at end of file
+    KWeightingFilter kWeighting;
+    std::array<double, KWeightingFilter::maxChannels> channelWeights {};
+    std::vector<float> silence;     // one step, read in place of channels the buffer lacks
+
+    // 100 ms steps
+    int stepSize = 4410;
+    int stepCounter = 0;
+    double stepEnergy = 0.0;                        // weighted sum of squares in the current step
+    std::array<double, stepsPerShortTerm> stepPower {}; // weighted mean square per finished step
+    int stepWriteIndex = 0;
+    int stepsFinished = 0;
+
+    LoudnessHistogram histogram;            // momentary blocks, for the integrated loudness
+    LoudnessHistogram shortTermHistogram;   // short-term values, for the range and statistics
+    std::atomic<bool> statisticsResetRequested{ false };
+
+    MeterEventLog* eventLog = nullptr;
+    std::atomic<float> loudnessTarget{ -14.0f };
+    bool aboveTarget = false;
+
+    // audio thread state, published through frames
+    float momentaryLufs;
+    float shortTermLufs;
+    float integratedLufs;
+    bool integratedValid;
+    float loudnessRange;
+    float rangeLowLufs;
+    float rangeHighLufs;
+    float shortTermMinLufs;
+    float shortTermMaxLufs;
+
+    AnalysisFramePool<Frame> frames;
+    juce::int64 samplesProcessed = 0;
+};
@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    LoudnessHistogram.cpp
+    Created: 15 Oct 2026 9:12:30pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#include "LoudnessHistogram.h"
+
+void LoudnessHistogram::reset() noexcept
+{
+    counts.fill(0);
+    powerSums.fill(0.0);
+    numBlocks = 0;
+}
+
+void LoudnessHistogram::add(double power) noexcept
+{
+    const double loudness = powerToLoudness(power);
+
+    if (loudness <= absoluteGate)
+        return;
+
+    const int bin = binOf(loudness);
+    ++counts[(size_t)bin];
+    powerSums[(size_t)bin] += power;
+    ++numBlocks;
+}
+
+double LoudnessHistogram::getMeanPower() const noexcept
+{
+    if (numBlocks == 0)
+        return 0.0;
+
+    double totalPower = 0.0;
+    for (int bin = 0; bin < numBins; ++bin)
+        totalPower += powerSums[(size_t)bin];
+
+    return totalPower / (double)numBlocks;
+}
+
+double LoudnessHistogram::getGatedPower(double relativeGate) const noexcept
+{
+    if (numBlocks == 0)
+        return 0.0;
+
+    // first pass: everything above the absolute gate
+    const double threshold = powerToLoudness(getMeanPower()) + relativeGate;
+
+    // second pass: bins above the relative gate
+    double gatedPower = 0.0;
+    juce::int64 gatedBlocks = 0;
+
+    for (int bin = binOf(threshold); bin < numBins; ++bin)
+    {
+        if (binCentre(bin) <= threshold)
+            continue;
+
+        gatedPower += powerSums[(size_t)bin];
+        gatedBlocks += counts[(size_t)bin];
+    }
+
+    return gatedBlocks > 0 ? gatedPower / (double)gatedBlocks : 0.0;
+}
+
+double LoudnessHistogram::getPercentile(double fraction, double gateLoudness) const noexcept
+{
+    const int firstBin = binOf(gateLoudness);
+
+    juce::int64 gatedBlocks = 0;
+    for (int bin = firstBin; bin < numBins; ++bin)
+        if (binCentre(bin) > gateLoudness)
+            gatedBlocks += counts[(size_t)bin];
+
+    if (gatedBlocks == 0)
+        return std::numeric_limits<double>::quiet_NaN();
+
+    const auto rank = (juce::int64)std::llround(juce::jlimit(0.0, 1.0, fraction) * (double)(gatedBlocks - 1));
+
+    juce::int64 below = 0;
+    for (int bin = firstBin; bin < numBins; ++bin)
+    {
+        const auto count = counts[(size_t)bin];
+        if (count == 0 || binCentre(bin) <= gateLoudness)
+            continue;
+
+        below += count;
+        if (below > rank)
+            return powerToLoudness(powerSums[(size_t)bin] / (double)count);
+    }
+
+    return std::numeric_limits<double>::quiet_NaN();
+}
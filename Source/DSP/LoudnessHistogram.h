@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    LoudnessHistogram.h
+    Created: 15 Oct 2026 9:12:30pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+
+// Fixed-size distribution of block loudness for gated measurements.
+//
+// Blocks above the -70 LUFS absolute gate are counted in 0.1 LU bins, and
+// every bin also keeps the exact sum of its blocks' power. A BS.1770 relative
+// gate is then two passes over the bins instead of over every block ever
+// measured: the means are exact and only the blocks sharing a bin with the
+// gate threshold are classified to within half a bin. Percentiles come from
+// the same counts, so a distribution of short-term loudness gives the EBU
+// Tech 3342 loudness range the same way. Memory is constant however long the
+// session runs.
+class LoudnessHistogram
+{
+public:
+    static constexpr double absoluteGate = -70.0;  // LUFS
+    static constexpr double maxLoudness = 10.0;    // anything louder lands in the top bin
+    static constexpr double binWidth = 0.1;        // LU
+    static constexpr int numBins = (int)((maxLoudness - absoluteGate) / binWidth);
+
+    void reset() noexcept;
+
+    // power: channel-weighted mean square of the block (before the -0.691 offset)
+    void add(double power) noexcept;
+
+    juce::int64 getNumBlocks() const noexcept { return numBlocks; }
+
+    // Mean power of all blocks above the absolute gate, or 0 when there are none
+    double getMeanPower() const noexcept;
+
+    // Mean power of the blocks louder than (mean of all blocks + relativeGate LU),
+    // or 0 when there are none
+    double getGatedPower(double relativeGate) const noexcept;
+
+    // Loudness of the block at the given fraction (0 = quietest, 1 = loudest)
+    // of those louder than gateLoudness, by nearest rank. The value returned is
+    // the power mean of that block's bin, so it is exact when the bin holds a
+    // single level. NaN when no block passes the gate.
+    double getPercentile(double fraction, double gateLoudness = absoluteGate) const noexcept;
+
+    static double powerToLoudness(double power) noexcept { return -0.691 + 10.0 * std::log10(power + 1.0e-20); }
+    static double loudnessToPower(double loudness) noexcept { return std::pow(10.0, (loudness + 0.691) * 0.1); }
+
+private:
+    static int binOf(double loudness) noexcept
+    {
+        return juce::jlimit(0, numBins - 1, (int)((loudness - absoluteGate) / binWidth));
+    }
+
+    static double binCentre(int bin) noexcept { return absoluteGate + (bin + 0.5) * binWidth; }
+
+    std::array<juce::int64, numBins> counts {};
+    std::array<double, numBins> powerSums {};
+    juce::int64 numBlocks = 0;
+};
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    MeterEventLog.cpp
+    Created: 15 Oct 2026 10:17:45pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#include "MeterEventLog.h"
+
+void MeterEventLog::prepare(double newSampleRate, int capacity)
+{
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+
+    events.assign((size_t)juce::jmax(2, capacity), {});
+    fifo.setTotalSize((int)events.size());
+    droppedEvents.store(0, std::memory_order_relaxed);
+
+    blockPosition = 0;
+    blockHostSamples = -1;
+    blockHostSeconds = -1.0;
+
+    // positions restart at zero, so earlier events would be out of order
+    const juce::ScopedLock sl(recentLock);
+    recentEnd = 0;
+    numRecent = 0;
+}
+
+void MeterEventLog::beginBlock(juce::int64 samplePosition, const juce::AudioPlayHead::PositionInfo* hostPosition) noexcept
+{
+    blockPosition = samplePosition;
+    blockHostSamples = -1;
+    blockHostSeconds = -1.0;
+
+    if (hostPosition == nullptr)
+        return;
+
+    if (const auto timeInSamples = hostPosition->getTimeInSamples())
+        blockHostSamples = *timeInSamples;
+
+    if (const auto timeInSeconds = hostPosition->getTimeInSeconds())
+        blockHostSeconds = *timeInSeconds;
+    else if (blockHostSamples >= 0)
+        blockHostSeconds = (double)blockHostSamples / sampleRate;
+}
+
+void MeterEventLog::push(MeterEvent::Type type, bool isStart, int channel, float value, int offsetInBlock) noexcept
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(1, start1, size1, start2, size2);
+
+    if (size1 == 0)
+    {
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto& event = events[(size_t)start1];
+    event.type = type;
+    event.isStart = isStart;
+    event.channel = channel;
+    event.value = value;
+    event.samplePosition = blockPosition + offsetInBlock;
+    event.hostTimeInSamples = blockHostSamples >= 0 ? blockHostSamples + offsetInBlock : -1;
+    event.hostTimeInSeconds = blockHostSeconds >= 0.0 ? blockHostSeconds + offsetInBlock / sampleRate : -1.0;
+
+    fifo.finishedWrite(1);
+}
+
+bool MeterEventLog::serviceAnalysis()
+{
+    const int numReady = fifo.getNumReady();
+    if (numReady <= 0)
+        return false;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(numReady, start1, size1, start2, size2);
+
+    {
+        const juce::ScopedLock sl(recentLock);
+
+        auto collect = [this](int start, int size)
+            {
+                for (int i = start; i < start + size; ++i)
+                {
+                    recentEvents[(size_t)recentEnd] = events[(size_t)i];
+                    recentEnd = (recentEnd + 1) % maxRecentEvents;
+                    numRecent = juce::jmin(numRecent + 1, maxRecentEvents);
+                }
+            };
+
+        collect(start1, size1);
+        collect(start2, size2);
+    }
+
+    fifo.finishedRead(size1 + size2);
+    return true;
+}
+
+int MeterEventLog::getRecentEvents(MeterEvent* dest, int maxEvents) const
+{
+    const juce::ScopedLock sl(recentLock);
+
+    const int count = juce::jmin(maxEvents, numRecent);
+    for (int i = 0; i < count; ++i)
+        dest[i] = recentEvents[(size_t)((recentEnd - count + i + maxRecentEvents) % maxRecentEvents)];
+
+    return count;
+}
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    MeterEventLog.h
+    Created: 15 Oct 2026 10:17:45pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <array>
+#include "AnalysisWorker.h"
+
+// Something a meter saw happen, stamped with where in the audio it happened
+struct MeterEvent
+{
+    enum class Type
+    {
+        samplePeakOver,         // a sample at or above 0 dBFS
+        truePeakOver,           // an interpolated sample above 0 dBTP
+        shortTermAboveTarget,   // short-term loudness above the loudness target
+        correlationNegative     // correlation below zero
+    };
+
+    Type type = Type::samplePeakOver;
+    bool isStart = true;        // false: the condition has cleared
+    int channel = -1;           // -1 when it isn't about one channel
+    float value = 0.0f;         // dBFS, dBTP, LUFS or correlation, by type
+
+    juce::int64 samplePosition = 0;     // samples since prepareToPlay
+    juce::int64 hostTimeInSamples = -1; // host timeline position, -1 when the host gave none
+    double hostTimeInSeconds = -1.0;
+};
+
+// Bounded single-producer / single-consumer queue of MeterEvents.
+//
+// The audio thread opens each block with the host's play position, then the
+// meters add events by their offset in the block and the log turns that into
+// session and timeline positions. If the queue is full the event is dropped
+// and counted; nothing ever waits.
+//
+// The analysis worker is the consumer: it moves the events into a small store
+// of the newest ones, which any number of readers (the editor, when there is
+// one) can copy. The queue keeps moving with no editor open, so one opened
+// later sees the latest events rather than what filled the queue.
+class MeterEventLog : public AnalysisWorker::Client
+{
+public:
+    static constexpr int maxRecentEvents = 32;
+
+    // Allocates; call while the audio thread and worker are stopped
+    void prepare(double sampleRate, int capacity = 1024);
+
+    // Audio thread: start of a block at samplePosition (samples since
+    // prepareToPlay), with the host position (nullptr if there is none)
+    void beginBlock(juce::int64 samplePosition, const juce::AudioPlayHead::PositionInfo* hostPosition) noexcept;
+
+    // Audio thread: an event offsetInBlock samples into the current block
+    // (negative for one the meter only saw after the block started)
+    void push(MeterEvent::Type type, bool isStart, int channel, float value, int offsetInBlock) noexcept;
+
+    // Worker thread: moves waiting events into the recent store
+    bool serviceAnalysis() override;
+
+    // Any thread but the audio thread: copies the newest events, at most
+    // maxEvents, oldest first, and returns how many there were
+    int getRecentEvents(MeterEvent* dest, int maxEvents) const;
+
+    int getNumDroppedEvents() const noexcept { return droppedEvents.load(std::memory_order_relaxed); }
+
+private:
+    juce::AbstractFifo fifo{ 1 };
+    std::vector<MeterEvent> events;
+    std::atomic<int> droppedEvents{ 0 };
+
+    double sampleRate = 44100.0;
+    juce::int64 blockPosition = 0;
+    juce::int64 blockHostSamples = -1;
+    double blockHostSeconds = -1.0;
+
+    // Ring of the newest events
+    juce::CriticalSection recentLock; // worker <-> readers only, never the audio thread
+    std::array<MeterEvent, maxRecentEvents> recentEvents;
+    int recentEnd = 0;      // slot the next event goes into
+    int numRecent = 0;
+};
@@ -0,0 +1,228 @@
+/*
+  ==============================================================================
+
+    MeterHistory.cpp
+    Created: 15 Oct 2026 9:58:33pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#include "MeterHistory.h"
+
+// bucket length and ring length of each level, finest first
+static constexpr double levelBucketSeconds[MeterHistory::numLevels] = { 0.1, 1.0, 10.0, 60.0 };
+static constexpr double levelSpanSeconds[MeterHistory::numLevels] = { 10.0 * 60.0, 2.0 * 3600.0, 24.0 * 3600.0, 7.0 * 24.0 * 3600.0 };
+
+MeterHistory::MeterHistory()
+{
+    for (int l = 0; l < numLevels; ++l)
+    {
+        auto& level = levels[(size_t)l];
+        level.bucketSeconds = levelBucketSeconds[l];
+        level.capacity = (int)(levelSpanSeconds[l] / levelBucketSeconds[l]) + guardBuckets;
+
+        if (l + 1 < numLevels)
+            level.bucketsPerParentBucket = juce::roundToInt(levelBucketSeconds[l + 1] / levelBucketSeconds[l]);
+
+        for (auto& series : level.buckets)
+            series.resize((size_t)level.capacity);
+    }
+}
+
+void MeterHistory::prepare(double sampleRate, int samplesPerBlock)
+{
+    samplesPerBaseBucket = juce::jmax(1, juce::roundToInt(sampleRate * levelBucketSeconds[0]));
+    samplesInBaseBucket = 0;
+
+    // a second of blocks, however small they are
+    const int capacity = juce::jmax(64, juce::roundToInt(sampleRate / juce::jmax(1, samplesPerBlock / 4)));
+    blockEntries.assign((size_t)capacity, {});
+    blockFifo.setTotalSize(capacity);
+
+    for (auto& level : levels)
+    {
+        for (auto& series : level.buckets)
+            std::fill(series.begin(), series.end(), Point());
+
+        level.pending.fill({});
+        level.pendingBuckets = 0;
+        level.numWritten.store(0, std::memory_order_release);
+    }
+}
+
+void MeterHistory::pushBlock(int numSamples, const Values& values) noexcept
+{
+    if (numSamples <= 0)
+        return;
+
+    int start1, size1, start2, size2;
+    blockFifo.prepareToWrite(1, start1, size1, start2, size2);
+
+    // full: the worker has stalled, the gap shows as missing buckets
+    if (size1 == 0)
+        return;
+
+    blockEntries[(size_t)start1] = { numSamples, values };
+    blockFifo.finishedWrite(1);
+}
+
+bool MeterHistory::serviceAnalysis()
+{
+    const int numReady = blockFifo.getNumReady();
+    if (numReady <= 0)
+        return false;
+
+    int start1, size1, start2, size2;
+    blockFifo.prepareToRead(numReady, start1, size1, start2, size2);
+
+    auto consume = [this](int start, int size)
+        {
+            for (int i = start; i < start + size; ++i)
+            {
+                const auto& entry = blockEntries[(size_t)i];
+
+                // Blocks are cut at bucket boundaries so the time axis stays exact
+                for (int remaining = entry.numSamples; remaining > 0;)
+                {
+                    const int n = juce::jmin(remaining, samplesPerBaseBucket - samplesInBaseBucket);
+                    addToBaseBucket(entry.values, n);
+
+                    samplesInBaseBucket += n;
+                    remaining -= n;
+
+                    if (samplesInBaseBucket == samplesPerBaseBucket)
+                    {
+                        samplesInBaseBucket = 0;
+                        closeBucket(0);
+                    }
+                }
+            }
+        };
+
+    consume(start1, size1);
+    consume(start2, size2);
+    blockFifo.finishedRead(size1 + size2);
+
+    return true;
+}
+
+void MeterHistory::addToBaseBucket(const Values& values, int numSamples) noexcept
+{
+    auto& pending = levels[0].pending;
+
+    for (int s = 0; s < numSeries; ++s)
+    {
+        float value = values[(size_t)s];
+        if (std::isnan(value))
+            continue;
+
+        if (s != correlation)
+            value = juce::jmax(floorDb, value);
+
+        auto& a = pending[(size_t)s];
+        a.min = juce::jmin(a.min, value);
+        a.max = juce::jmax(a.max, value);
+        a.weightedSum += (double)value * numSamples;
+        a.weight += numSamples;
+    }
+}
+
+void MeterHistory::closeBucket(int levelIndex) noexcept
+{
+    auto& level = levels[(size_t)levelIndex];
+    const auto written = level.numWritten.load(std::memory_order_relaxed);
+    const auto slot = (size_t)(written % level.capacity);
+
+    for (int s = 0; s < numSeries; ++s)
+    {
+        auto& a = level.pending[(size_t)s];
+        Point point;
+
+        if (a.weight > 0.0)
+            point = { a.min, a.max, (float)(a.weightedSum / a.weight) };
+
+        level.buckets[s][slot] = point;
+        a = {};
+
+        // the parent weighs every measured bucket the same
+        if (levelIndex + 1 < numLevels && !std::isnan(point.mean))
+        {
+            auto& p = levels[(size_t)levelIndex + 1].pending[(size_t)s];
+            p.min = juce::jmin(p.min, point.min);
+            p.max = juce::jmax(p.max, point.max);
+            p.weightedSum += point.mean;
+            p.weight += 1.0;
+        }
+    }
+
+    level.numWritten.store(written + 1, std::memory_order_release);
+
+    if (levelIndex + 1 < numLevels)
+    {
+        auto& parent = levels[(size_t)levelIndex + 1];
+        if (++parent.pendingBuckets == level.bucketsPerParentBucket)
+        {
+            parent.pendingBuckets = 0;
+            closeBucket(levelIndex + 1);
+        }
+    }
+}
+
+void MeterHistory::read(Series series, double durationSeconds, Point* points, int numPoints) const
+{
+    if (points == nullptr || numPoints <= 0 || durationSeconds <= 0.0)
+        return;
+
+    std::fill(points, points + numPoints, Point());
+
+    const double secondsPerPoint = durationSeconds / numPoints;
+
+    // The coarsest level with at least one bucket per point, or a coarser one
+    // if that doesn't reach back far enough
+    int levelIndex = 0;
+    while (levelIndex + 1 < numLevels && levels[(size_t)levelIndex + 1].bucketSeconds <= secondsPerPoint)
+        ++levelIndex;
+
+    while (levelIndex + 1 < numLevels && levelSpanSeconds[levelIndex] < durationSeconds)
+        ++levelIndex;
+
+    const auto& level = levels[(size_t)levelIndex];
+    const auto written = level.numWritten.load(std::memory_order_acquire);
+    const auto oldestReadable = written - (level.capacity - guardBuckets);
+
+    const double bucketsPerPoint = secondsPerPoint / level.bucketSeconds;
+    const double firstBucket = (double)written - durationSeconds / level.bucketSeconds;
+    const auto& buckets = level.buckets[series];
+
+    for (int p = 0; p < numPoints; ++p)
+    {
+        // at least one bucket per point, even when zoomed in past the finest level
+        const auto begin = (juce::int64)std::floor(firstBucket + p * bucketsPerPoint);
+        const auto end = juce::jmax(begin + 1, (juce::int64)std::floor(firstBucket + (p + 1) * bucketsPerPoint));
+
+        auto& point = points[p];
+        double sum = 0.0;
+        int count = 0;
+
+        for (auto b = juce::jmax(begin, oldestReadable, (juce::int64)0); b < juce::jmin(end, written); ++b)
+        {
+            const auto& bucket = buckets[(size_t)(b % level.capacity)];
+            if (std::isnan(bucket.mean))
+                continue;
+
+            point.min = count == 0 ? bucket.min : juce::jmin(point.min, bucket.min);
+            point.max = count == 0 ? bucket.max : juce::jmax(point.max, bucket.max);
+            sum += bucket.mean;
+            ++count;
+        }
+
+        if (count > 0)
+            point.mean = (float)(sum / count);
+    }
+}
+
+double MeterHistory::getRecordedSeconds() const noexcept
+{
+    return (double)levels[0].numWritten.load(std::memory_order_acquire) * levels[0].bucketSeconds;
+}
@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    MeterHistory.h
+    Created: 15 Oct 2026 9:58:33pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include "AnalysisWorker.h"
+
+// Meter values over time, for graphs of a whole session.
+//
+// The audio thread hands over one set of values per block through a small
+// lock-free queue. The worker folds them into a pyramid of min/max/mean
+// buckets: 100 ms, 1 s, 10 s and 1 min, each level a preallocated ring
+// (10 minutes, 2 hours, 24 hours and 7 days). A reader picks the coarsest
+// level that still has a bucket per point, so any zoom costs O(points).
+//
+// Buckets are published by a per-level count (release/acquire). The reader
+// stays guardBuckets clear of the oldest slot, the only one the worker can be
+// rewriting while it reads.
+class MeterHistory : public AnalysisWorker::Client
+{
+public:
+    enum Series { momentary, shortTerm, truePeak, correlation, numSeries };
+
+    static constexpr int numLevels = 4;
+    static constexpr float floorDb = -100.0f; // quieter loudness / peaks are recorded as this
+
+    struct Point
+    {
+        float min = std::numeric_limits<float>::quiet_NaN();   // all NaN: nothing measured
+        float max = std::numeric_limits<float>::quiet_NaN();
+        float mean = std::numeric_limits<float>::quiet_NaN();
+    };
+
+    using Values = std::array<float, numSeries>;
+
+    MeterHistory();
+    ~MeterHistory() override = default;
+
+    // Allocates and clears the history; call while the worker is stopped
+    void prepare(double sampleRate, int samplesPerBlock);
+
+    // Audio thread: the meters' values for a block, NaN where there is none yet
+    void pushBlock(int numSamples, const Values& values) noexcept;
+
+    // Worker thread
+    bool serviceAnalysis() override;
+
+    // Any thread. Fills numPoints points covering the last durationSeconds,
+    // oldest first; points before the start of the recording stay NaN.
+    void read(Series series, double durationSeconds, Point* points, int numPoints) const;
+
+    // Any thread
+    double getRecordedSeconds() const noexcept;
+
+private:
+    struct BlockEntry
+    {
+        int numSamples = 0;
+        Values values {};
+    };
+
+    struct Accumulator
+    {
+        float min = std::numeric_limits<float>::max();
+        float max = std::numeric_limits<float>::lowest();
+        double weightedSum = 0.0;
+        double weight = 0.0;
+    };
+
+    struct Level
+    {
+        double bucketSeconds = 0.1;
+        int capacity = 0;
+        int bucketsPerParentBucket = 10;    // unused on the top level
+        std::vector<Point> buckets[numSeries];
+        std::atomic<juce::int64> numWritten{ 0 };
+
+        std::array<Accumulator, numSeries> pending;
+        int pendingBuckets = 0;             // of the level below
+    };
+
+    static constexpr int guardBuckets = 64;
+
+    void addToBaseBucket(const Values& values, int numSamples) noexcept;
+    void closeBucket(int level) noexcept;
+
+    juce::AbstractFifo blockFifo{ 1 };
+    std::vector<BlockEntry> blockEntries;
+
+    std::array<Level, numLevels> levels;
+    int samplesPerBaseBucket = 4800;
+    int samplesInBaseBucket = 0;
+};
@@ -0,0 +1,198 @@
+/*
+  ==============================================================================
+
+    MultiResolutionSpectrumAnalyzer.cpp
+    Created: 15 Oct 2026 3:21:09pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#include "MultiResolutionSpectrumAnalyzer.h"
+
+// Usable band of every decimated stage as a fraction of its Nyquist. The top
+// edge is where the half-band filter is still flat and alias-free, the bottom
+// edge is half of that so the stages tile the spectrum an octave at a time.
+static constexpr float stageBandTop = 0.8f;
+static constexpr float stageBandBottom = 0.4f;
+
+// Same ballistics as SpectrumAnalyzer's full-band smoothing, with the release
+// ramped over frequency from 0 Hz to Nyquist
+static constexpr float pointAttack = SpectrumAnalyzer::toPowerCoefficient(0.6f);
+static constexpr float pointReleaseLow = 0.05f;
+static constexpr float pointReleaseHigh = 0.4f;
+
+MultiResolutionSpectrumAnalyzer::MultiResolutionSpectrumAnalyzer(int stageCount, int orderPerStage, int points)
+    : numStages(juce::jmax(1, stageCount)),
+    fftOrder(orderPerStage),
+    numPoints(juce::jmax(2, points))
+{
+    // updateSmoothedMagnitudes() asks every stage for its frames, in power so
+    // the stitching and smoothing need no sqrt
+    for (int s = 0; s < numStages; ++s)
+    {
+        stages.push_back(std::make_unique<SpectrumAnalyzer>(fftOrder, 2));
+        stages.back()->setScheduling(SpectrumAnalyzer::Scheduling::onDemand);
+        stages.back()->setMagnitudeScale(SpectrumAnalyzer::MagnitudeScale::power);
+    }
+
+    decimators.resize((size_t)(numStages - 1));
+    stageInput.resize((size_t)numStages);
+
+    for (auto& scratch : stageInput)
+        for (auto& channel : scratch)
+            channel.assign(maxBlock, 0.0f);
+
+    pointMap.resize((size_t)numPoints);
+    pointPower[0].assign((size_t)numPoints, 0.0f);
+    pointPower[1].assign((size_t)numPoints, 0.0f);
+}
+
+void MultiResolutionSpectrumAnalyzer::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+    ring.prepare(2, juce::jmax(4 * maxBlock, juce::nextPowerOfTwo((int)(sampleRate * 0.1))));
+
+    double stageRate = sampleRate;
+    for (auto& stage : stages)
+    {
+        stage->prepareToPlay(stageRate, samplesPerBlock);
+        stageRate *= 0.5;
+    }
+
+    for (auto& pair : decimators)
+        for (auto& d : pair)
+            d.reset();
+
+    buildPointMap(sampleRate);
+}
+
+void MultiResolutionSpectrumAnalyzer::buildPointMap(double sampleRate)
+{
+    const double nyquist = sampleRate * 0.5;
+    const int fftSize = 1 << fftOrder;
+    const int numBins = fftSize / 2;
+
+    const double logMin = std::log10((double)minFrequency);
+    const double logMax = std::log10(nyquist);
+
+    auto frequencyOf = [&](double point)
+        {
+            return std::pow(10.0, logMin + point / (numPoints - 1) * (logMax - logMin));
+        };
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const double freq = frequencyOf(i);
+
+        // Coarsest stage whose alias-free band still contains freq
+        int stage = 0;
+        while (stage + 1 < numStages && freq < stageBandBottom * (nyquist / (1 << stage)))
+            ++stage;
+
+        const double stageRate = sampleRate / (1 << stage);
+        const double binWidth = stageRate / fftSize;
+
+        // Bins covered by this point's share of the log axis
+        const double lo = frequencyOf(i - 0.5) / binWidth;
+        const double hi = frequencyOf(i + 0.5) / binWidth;
+
+        auto& m = pointMap[i];
+        m.stage = stage;
+        m.release = SpectrumAnalyzer::toPowerCoefficient(
+            juce::jmap((float)(freq / nyquist), pointReleaseLow, pointReleaseHigh));
+        m.firstBin = juce::jlimit(1, numBins - 1, (int)std::ceil(lo));
+        m.lastBin = juce::jlimit(1, numBins - 1, (int)std::floor(hi));
+
+        if (m.lastBin <= m.firstBin)
+        {
+            // narrower than a bin: interpolate between neighbours instead
+            const double bin = juce::jlimit(1.0, (double)(numBins - 2), freq / binWidth);
+            m.firstBin = m.lastBin = (int)bin;
+            m.frac = (float)(bin - m.firstBin);
+        }
+        else
+        {
+            m.frac = 0.0f;
+        }
+    }
+}
+
+void MultiResolutionSpectrumAnalyzer::pushAudioBlock(const float* left, const float* right, int numSamples)
+{
+    if (!left || !right || numSamples <= 0)
+        return;
+
+    const float* inputs[2] = { left, right };
+    ring.push(inputs, numSamples);
+}
+
+bool MultiResolutionSpectrumAnalyzer::serviceAnalysis()
+{
+    if (ring.getNumReady() <= 0)
+        return false;
+
+    ring.read(ring.getNumReady(), [this](const float* const* data, int numSamples)
+        {
+            for (int offset = 0; offset < numSamples; offset += maxBlock)
+            {
+                int n = juce::jmin(maxBlock, numSamples - offset);
+                const float* input[2] = { data[0] + offset, data[1] + offset };
+
+                for (int s = 0; s < numStages && n > 0; ++s)
+                {
+                    stages[s]->appendToHistory(input, n);
+
+                    if (s + 1 >= numStages)
+                        break;
+
+                    // decimate into the next stage's scratch
+                    auto& next = stageInput[s + 1];
+                    int produced = 0;
+                    for (int ch = 0; ch < 2; ++ch)
+                        produced = decimators[s][ch].process(input[ch], next[ch].data(), n);
+
+                    input[0] = next[0].data();
+                    input[1] = next[1].data();
+                    n = produced;
+                }
+            }
+        });
+
+    return true;
+}
+
+void MultiResolutionSpectrumAnalyzer::updateSmoothedMagnitudes()
+{
+    // Raw frames: smoothing each stage over its own bins would give every
+    // stage a different release at the same frequency
+    for (auto& stage : stages)
+        stage->acquireLatestFrame();
+
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        auto& out = pointPower[ch];
+
+        for (int i = 0; i < numPoints; ++i)
+        {
+            const auto& m = pointMap[i];
+            const auto& powers = stages[m.stage]->getLatestFrame()->magnitude[ch];
+
+            float input;
+
+            if (m.firstBin == m.lastBin)
+            {
+                input = juce::jmap(m.frac, powers[m.firstBin], powers[m.firstBin + 1]);
+            }
+            else
+            {
+                // keep peaks when several bins share one point
+                input = 0.0f;
+                for (int bin = m.firstBin; bin <= m.lastBin; ++bin)
+                    input = juce::jmax(input, powers[bin]);
+            }
+
+            const float coefficient = input > out[i] ? pointAttack : m.release;
+            out[i] += coefficient * (input - out[i]);
+        }
+    }
+}
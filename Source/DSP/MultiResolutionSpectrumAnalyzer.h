@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    MultiResolutionSpectrumAnalyzer.h
+    Created: 15 Oct 2026 3:21:09pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "SpectrumAnalyzer.h"
+#include "HalfBandDecimator.h"
+#include "SampleRing.h"
+
+// Stereo spectrum with roughly constant resolution per octave.
+//
+// The input runs through a cascade of half-band decimators and every stage
+// feeds its own (small) SpectrumAnalyzer, so stage s sees the signal at
+// sampleRate / 2^s with the same FFT size. Each stage covers the octave where
+// its resolution is best and its decimator is alias-free, and the raw stage
+// frames are stitched into one log-frequency power array from minFrequency to
+// Nyquist. Attack/release smoothing runs afterwards, per output point, with a
+// release that follows the point's frequency, so the ballistics are continuous
+// across the seams between stages.
+//
+// With the defaults (5 stages of 4096 points) the lowest octaves get the bin
+// spacing of a 64k transform while the top octave updates every 1024 samples.
+class MultiResolutionSpectrumAnalyzer : public AnalysisWorker::Client
+{
+public:
+    MultiResolutionSpectrumAnalyzer(int numStages = 5, int fftOrderPerStage = 12, int numPoints = 1024);
+    ~MultiResolutionSpectrumAnalyzer() override = default;
+
+    // Call while the analysis worker is stopped
+    void prepareToPlay(double sampleRate, int samplesPerBlock);
+
+    // Any thread. Upper limit on how often each stage makes a frame on demand
+    void setMaxFrameRate(float framesPerSecond) noexcept
+    {
+        for (auto& stage : stages)
+            stage->setMaxFrameRate(framesPerSecond);
+    }
+
+    // Any thread. While inactive the stages keep their histories filled (the
+    // decimators still run) but skip their FFTs; see SpectrumAnalyzer::setActive.
+    void setActive(bool shouldBeActive) noexcept
+    {
+        for (auto& stage : stages)
+            stage->setActive(shouldBeActive);
+    }
+
+    // Audio thread: bounded copy into the ring, never blocks
+    void pushAudioBlock(const float* left, const float* right, int numSamples);
+
+    // Worker thread: decimation and all stage FFTs
+    bool serviceAnalysis() override;
+
+    // GUI thread: stitches the newest stage frames into the log-frequency arrays
+    // and smooths them
+    void updateSmoothedMagnitudes();
+
+    // Smoothed power per point (full-scale sine = 1.0)
+    const std::vector<float>& getPointPowers(int channel) const noexcept { return pointPower[channel]; }
+
+    // Point i sits at minFrequency * (nyquist / minFrequency)^(i / (numPoints - 1))
+    int getNumPoints() const noexcept { return numPoints; }
+    static constexpr float minFrequency = 20.0f;
+
+private:
+    struct PointMapping
+    {
+        int stage = 0;
+        int firstBin = 0;   // bins [firstBin, lastBin] fall into this point
+        int lastBin = 0;
+        float frac = 0.0f;  // interpolation weight when firstBin == lastBin
+        float release = 0.0f;
+    };
+
+    void buildPointMap(double sampleRate);
+
+    static constexpr int maxBlock = 1024;
+
+    const int numStages;
+    const int fftOrder;
+    const int numPoints;
+
+    SampleRing ring;
+
+    std::vector<std::unique_ptr<SpectrumAnalyzer>> stages;
+    std::vector<std::array<HalfBandDecimator, 2>> decimators; // decimators[s] feeds stage s + 1
+    std::vector<std::array<std::vector<float>, 2>> stageInput; // per-stage scratch, worker only
+
+    std::vector<PointMapping> pointMap;
+    std::vector<float> pointPower[2]; // GUI thread only
+};
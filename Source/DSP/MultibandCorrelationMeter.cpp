@@ -0,0 +1,248 @@
+/*
+  ==============================================================================
+
+    MultibandCorrelationMeter.cpp
+    Created: 15 Oct 2026 7:14:37pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#include "MultibandCorrelationMeter.h"
+
+static constexpr double bankLowestEdge = 20.0;
+static constexpr double bankHighestEdge = 20000.0;
+
+// Below this (about -100 dB) a band counts as silent
+static constexpr float silentPower = 1.0e-10f;
+
+namespace
+{
+    enum class SectionType { lowPass, highPass, bypass, mute };
+
+    // Butterworth (Q = 1/sqrt(2)) section, bilinear transform
+    void setSection(float* b0, float* b1, float* b2, float* a1, float* a2, int lane,
+                    SectionType type, double frequency, double sampleRate)
+    {
+        if (type == SectionType::bypass || type == SectionType::mute)
+        {
+            b0[lane] = type == SectionType::bypass ? 1.0f : 0.0f;
+            b1[lane] = b2[lane] = a1[lane] = a2[lane] = 0.0f;
+            return;
+        }
+
+        const double w0 = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+        const double cosW0 = std::cos(w0);
+        const double alpha = std::sin(w0) / juce::MathConstants<double>::sqrt2; // sin(w0) / 2Q
+        const double a0 = 1.0 + alpha;
+
+        const double b1Raw = type == SectionType::lowPass ? 1.0 - cosW0 : -(1.0 + cosW0);
+        const double b0Raw = std::abs(b1Raw) * 0.5;
+
+        b0[lane] = (float)(b0Raw / a0);
+        b1[lane] = (float)(b1Raw / a0);
+        b2[lane] = (float)(b0Raw / a0);
+        a1[lane] = (float)(-2.0 * cosW0 / a0);
+        a2[lane] = (float)((1.0 - alpha) / a0);
+    }
+}
+
+MultibandCorrelationMeter::MultibandCorrelationMeter()
+{
+    frames.initialise([](Frame&) {});
+}
+
+void MultibandCorrelationMeter::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+    currentSampleRate = sampleRate;
+    ring.prepare(2, juce::jmax(4 * samplesPerBlock, juce::nextPowerOfTwo((int)(sampleRate * 0.1))));
+
+    samplesPerFrame = juce::jmax(1, juce::roundToInt(sampleRate / 60.0));
+    samplesSinceFrame = 0;
+    samplesProcessed = 0;
+
+    // force a redesign for the new rate
+    numBands = 0;
+    integrationMs = 0.0f;
+    applySettings();
+}
+
+void MultibandCorrelationMeter::pushAudioBlock(const float* left, const float* right, int numSamples)
+{
+    if (left == nullptr || right == nullptr || numSamples <= 0 || !active.load(std::memory_order_relaxed))
+        return;
+
+    const float* inputs[2] = { left, right };
+    ring.push(inputs, numSamples);
+}
+
+bool MultibandCorrelationMeter::serviceAnalysis()
+{
+    // Coming back from a pause: the filter state and sums belong to old audio
+    const bool shouldFilter = active.load(std::memory_order_relaxed);
+    if (shouldFilter && !filtering)
+        restartStatistics();
+
+    filtering = shouldFilter;
+
+    if (ring.getNumReady() <= 0)
+        return false;
+
+    juce::ScopedNoDenormals noDenormals;
+
+    applySettings();
+
+    ring.read(ring.getNumReady(), [this](const float* const* data, int numSamples)
+        {
+            process(data[0], data[1], numSamples);
+        });
+
+    return true;
+}
+
+void MultibandCorrelationMeter::applySettings()
+{
+    const int bands = requestedBands.load(std::memory_order_relaxed);
+    const float milliseconds = requestedIntegrationMs.load(std::memory_order_relaxed);
+
+    if (milliseconds != integrationMs)
+    {
+        integrationMs = milliseconds;
+        smoothing = (float)(1.0 - std::exp(-1.0 / (juce::jmax(1.0f, milliseconds) * 0.001 * currentSampleRate)));
+    }
+
+    if (bands != numBands)
+        designBank(bands);
+}
+
+void MultibandCorrelationMeter::designBank(int bands)
+{
+    numBands = bands;
+
+    const double top = juce::jmin(bankHighestEdge, currentSampleRate * 0.45);
+
+    for (int e = 0; e <= maxBands; ++e)
+        edgeHz[e] = e <= numBands ? (float)(bankLowestEdge * std::pow(top / bankLowestEdge, (double)e / numBands)) : 0.0f;
+
+    for (int b = 0; b < maxBands; ++b)
+    {
+        const bool used = b < numBands;
+        const SectionType highPass = !used ? SectionType::mute : (b == 0 ? SectionType::bypass : SectionType::highPass);
+        const SectionType lowPass = !used ? SectionType::mute : (b == numBands - 1 ? SectionType::bypass : SectionType::lowPass);
+
+        for (int s = 0; s < numSections; ++s)
+        {
+            auto& c = sections[s];
+            const bool isHighPassHalf = s < numSections / 2;
+
+            setSection(c.b0, c.b1, c.b2, c.a1, c.a2, b,
+                       isHighPassHalf ? highPass : lowPass,
+                       isHighPassHalf ? edgeHz[b] : edgeHz[b + 1],
+                       currentSampleRate);
+        }
+    }
+
+    // new filters, new statistics
+    restartStatistics();
+}
+
+void MultibandCorrelationMeter::restartStatistics() noexcept
+{
+    for (auto& channel : state)
+        for (auto& s : channel)
+        {
+            std::fill(std::begin(s.z1), std::end(s.z1), 0.0f);
+            std::fill(std::begin(s.z2), std::end(s.z2), 0.0f);
+        }
+
+    std::fill(std::begin(sumLR), std::end(sumLR), 0.0f);
+    std::fill(std::begin(sumLL), std::end(sumLL), 0.0f);
+    std::fill(std::begin(sumRR), std::end(sumRR), 0.0f);
+}
+
+void MultibandCorrelationMeter::filterSample(float input, int channel, float* bandOut) noexcept
+{
+    alignas(32) float x[maxBands];
+    std::fill(std::begin(x), std::end(x), input);
+
+    // Transposed direct form II; every loop below is over the band lanes only
+    for (int s = 0; s < numSections; ++s)
+    {
+        const auto& c = sections[s];
+        auto& z = state[channel][s];
+
+        for (int b = 0; b < maxBands; ++b)
+        {
+            const float y = c.b0[b] * x[b] + z.z1[b];
+            z.z1[b] = c.b1[b] * x[b] - c.a1[b] * y + z.z2[b];
+            z.z2[b] = c.b2[b] * x[b] - c.a2[b] * y;
+            x[b] = y;
+        }
+    }
+
+    std::copy(std::begin(x), std::end(x), bandOut);
+}
+
+void MultibandCorrelationMeter::process(const float* left, const float* right, int numSamples) noexcept
+{
+    alignas(32) float bandL[maxBands];
+    alignas(32) float bandR[maxBands];
+
+    const float k = smoothing;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        filterSample(left[i], 0, bandL);
+        filterSample(right[i], 1, bandR);
+
+        for (int b = 0; b < maxBands; ++b)
+        {
+            sumLR[b] += k * (bandL[b] * bandR[b] - sumLR[b]);
+            sumLL[b] += k * (bandL[b] * bandL[b] - sumLL[b]);
+            sumRR[b] += k * (bandR[b] * bandR[b] - sumRR[b]);
+        }
+
+        if (++samplesSinceFrame >= samplesPerFrame)
+        {
+            samplesProcessed += samplesSinceFrame;
+            samplesSinceFrame = 0;
+            publishFrame();
+        }
+    }
+}
+
+void MultibandCorrelationMeter::publishFrame()
+{
+    auto* frame = frames.getFreeFrame();
+    if (frame == nullptr)
+        return;
+
+    frame->numBands = numBands;
+    std::copy(std::begin(edgeHz), std::end(edgeHz), frame->edgeHz);
+
+    for (int b = 0; b < numBands; ++b)
+    {
+        const float lr = sumLR[b];
+        const float ll = sumLL[b];
+        const float rr = sumRR[b];
+
+        float correlation = 0.0f;
+        if (ll > silentPower && rr > silentPower)
+            correlation = juce::jlimit(-1.0f, 1.0f, lr / std::sqrt(ll * rr));
+
+        // M = (L + R) / 2, S = (L - R) / 2
+        const float mid = 0.25f * (ll + rr + 2.0f * lr);
+        const float side = 0.25f * (ll + rr - 2.0f * lr);
+
+        float width = 0.0f;
+        if (mid > silentPower)
+            width = juce::jlimit(0.0f, 2.0f, std::sqrt(juce::jmax(0.0f, side) / mid));
+        else if (side > silentPower)
+            width = 2.0f; // side only
+
+        frame->correlation[b] = correlation;
+        frame->width[b] = width;
+    }
+
+    frames.publish(frame, samplesProcessed);
+}
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    SampleRing.h
+    Created: 15 Oct 2026 2:40:51pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+
+// Lock-free single-producer / single-consumer ring of multichannel samples.
+// The audio thread pushes, a worker (or the GUI) reads. If the reader falls
+// behind, the samples that don't fit are dropped and counted instead of blocking.
+class SampleRing
+{
+public:
+    static constexpr int maxChannels = 2;
+
+    // Allocates; call while neither side is running
+    void prepare(int channels, int capacity)
+    {
+        numChannels = juce::jlimit(1, maxChannels, channels);
+        for (int ch = 0; ch < numChannels; ++ch)
+            buffers[ch].assign((size_t)capacity, 0.0f);
+        fifo.setTotalSize(capacity);
+        droppedSamples.store(0, std::memory_order_relaxed);
+    }
+
+    // Producer side. Returns the number of samples actually written.
+    int push(const float* const* channels, int numSamples) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            if (size1 > 0)
+                juce::FloatVectorOperations::copy(buffers[ch].data() + start1, channels[ch], size1);
+            if (size2 > 0)
+                juce::FloatVectorOperations::copy(buffers[ch].data() + start2, channels[ch] + size1, size2);
+        }
+
+        fifo.finishedWrite(size1 + size2);
+
+        if (size1 + size2 < numSamples)
+            droppedSamples.fetch_add(numSamples - size1 - size2, std::memory_order_relaxed);
+
+        return size1 + size2;
+    }
+
+    int getNumReady() const noexcept { return fifo.getNumReady(); }
+
+    // Consumer side. Calls fn(const float* const* channelData, int numSamples) for
+    // each contiguous run (at most two) and returns the total number consumed.
+    template <typename Fn>
+    int read(int maxSamples, Fn&& fn)
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(maxSamples, start1, size1, start2, size2);
+
+        const float* run[maxChannels] = {};
+
+        if (size1 > 0)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                run[ch] = buffers[ch].data() + start1;
+            fn(run, size1);
+        }
+
+        if (size2 > 0)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                run[ch] = buffers[ch].data() + start2;
+            fn(run, size2);
+        }
+
+        fifo.finishedRead(size1 + size2);
+        return size1 + size2;
+    }
+
+    int getNumDroppedSamples() const noexcept { return droppedSamples.load(std::memory_order_relaxed); }
+
+private:
+    int numChannels = 1;
+    juce::AbstractFifo fifo{ 1 };
+    std::vector<float> buffers[maxChannels];
+    std::atomic<int> droppedSamples{ 0 };
+};
@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+    SpectrogramImage.cpp
+    Created: 15 Oct 2026 6:10:42pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#include "SpectrogramImage.h"
+
+static constexpr float spectrogramMinFrequency = 20.0f;
+
+SpectrogramImage::SpectrogramImage()
+{
+    // black -> deep blue -> magenta -> orange -> pale yellow
+    const juce::Colour stops[] = { juce::Colour(0xff000000), juce::Colour(0xff10106a), juce::Colour(0xff9b1e8c),
+                                   juce::Colour(0xfff36b1f), juce::Colour(0xfffff3b0) };
+    constexpr int numStops = (int)(sizeof(stops) / sizeof(stops[0]));
+
+    for (int i = 0; i < lutSize; ++i)
+    {
+        const float position = (float)i / (float)(lutSize - 1) * (numStops - 1);
+        const int stop = juce::jmin((int)position, numStops - 2);
+
+        colourLut[(size_t)i] = stops[stop].interpolatedWith(stops[stop + 1], position - stop).getPixelARGB();
+    }
+
+    columnTimestamps.assign((size_t)numColumns, -1);
+}
+
+void SpectrogramImage::setHeight(int newHeight)
+{
+    newHeight = juce::jmax(1, newHeight);
+
+    if (image.isValid() && image.getHeight() == newHeight)
+        return;
+
+    image = juce::Image(juce::Image::ARGB, numColumns, newHeight, true);
+    rowValues.assign((size_t)newHeight, 0.0f);
+    writeColumnIndex = 0;
+    std::fill(columnTimestamps.begin(), columnTimestamps.end(), -1);
+}
+
+void SpectrogramImage::setFrequencyMap(double sampleRate, int numBins)
+{
+    if (!image.isValid() || rowMap.matches(image.getHeight(), sampleRate, numBins))
+        return;
+
+    rowMap.build(image.getHeight(), sampleRate, numBins, spectrogramMinFrequency);
+    mapSampleRate = sampleRate;
+}
+
+void SpectrogramImage::addFrame(const float* magnitudes, bool magnitudesArePower, juce::int64 timestamp)
+{
+    if (!image.isValid() || rowMap.getNumColumns() != image.getHeight())
+        return;
+
+    const auto last = columnTimestamps[(size_t)((writeColumnIndex + numColumns - 1) % numColumns)];
+    const auto minSpacing = (juce::int64)(mapSampleRate / maxColumnsPerSecond);
+
+    // Timestamps only go backwards after a restart; the old columns no longer
+    // line up with the new ones, so only their picture is kept
+    if (timestamp < last)
+        std::fill(columnTimestamps.begin(), columnTimestamps.end(), -1);
+    else if (last >= 0 && timestamp - last < juce::jmax((juce::int64)1, minSpacing))
+        return;
+
+    rowMap.apply(magnitudes, rowValues.data(), SpectrumDisplayMap::Aggregation::max);
+
+    const float dbPerDecade = magnitudesArePower ? 10.0f : 20.0f;
+
+    for (auto& value : rowValues)
+        value = value > 0.0f ? juce::jmax(minDb, dbPerDecade * std::log10(value)) : minDb;
+
+    columnTimestamps[(size_t)writeColumnIndex] = timestamp;
+    writeColumn(rowValues.data());
+}
+
+double SpectrogramImage::getHistorySeconds() const noexcept
+{
+    const auto newest = columnTimestamps[(size_t)((writeColumnIndex + numColumns - 1) % numColumns)];
+    if (newest < 0 || mapSampleRate <= 0.0)
+        return 0.0;
+
+    // The oldest written column: the next one to be overwritten, unless the ring isn't full yet
+    auto oldest = columnTimestamps[(size_t)writeColumnIndex];
+    for (int i = writeColumnIndex; oldest < 0 && i < writeColumnIndex + numColumns; ++i)
+        oldest = columnTimestamps[(size_t)(i % numColumns)];
+
+    return (double)(newest - oldest) / mapSampleRate;
+}
+
+void SpectrogramImage::writeColumn(const float* rowsDb)
+{
+    const int height = image.getHeight();
+    juce::Image::BitmapData bitmap(image, writeColumnIndex, 0, 1, height, juce::Image::BitmapData::writeOnly);
+
+    // row 0 of the map is the lowest frequency, which goes at the bottom of the image
+    for (int row = 0; row < height; ++row)
+    {
+        const int index = juce::jlimit(0, lutSize - 1, (int)((rowsDb[row] - minDb) * lutStepsPerDb));
+
+        *reinterpret_cast<juce::PixelARGB*>(bitmap.getPixelPointer(0, height - 1 - row)) = colourLut[(size_t)index];
+    }
+
+    writeColumnIndex = (writeColumnIndex + 1) % numColumns;
+}
+
+void SpectrogramImage::draw(juce::Graphics& g, juce::Rectangle<int> area) const
+{
+    if (!image.isValid() || area.isEmpty())
+        return;
+
+    const int height = image.getHeight();
+
+    // Oldest columns are [writeColumnIndex, numColumns), newest [0, writeColumnIndex)
+    const int olderColumns = numColumns - writeColumnIndex;
+    const int splitX = area.getX() + juce::roundToInt((float)olderColumns * (float)area.getWidth() / (float)numColumns);
+
+    g.drawImage(image, area.getX(), area.getY(), splitX - area.getX(), area.getHeight(),
+                writeColumnIndex, 0, olderColumns, height);
+
+    if (writeColumnIndex > 0)
+        g.drawImage(image, splitX, area.getY(), area.getRight() - splitX, area.getHeight(),
+                    0, 0, writeColumnIndex, height);
+}
+
+float SpectrogramImage::getFrequencyPosition(float frequency) const noexcept
+{
+    if (mapSampleRate <= 0.0)
+        return 0.0f;
+
+    const float logMin = std::log10(spectrogramMinFrequency);
+    const float logMax = std::log10((float)mapSampleRate * 0.5f);
+
+    return (std::log10(juce::jmax(frequency, spectrogramMinFrequency)) - logMin) / (logMax - logMin);
+}
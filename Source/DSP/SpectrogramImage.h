@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    SpectrogramImage.h
+    Created: 15 Oct 2026 6:10:42pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "SpectrumDisplayMap.h"
+
+// Scrolling spectrogram kept in a fixed-size circular image (GUI thread only).
+//
+// Every new analysis frame becomes one column, so transients land in the
+// column of the frame that caught them. Frames closer together than
+// 1 / maxColumnsPerSecond of audio are skipped, which bounds the ring: it holds
+// at least historySeconds, more when frames come slower, and memory only
+// depends on the view height. Writing a column is one display-map pass plus a
+// colour lookup per row; nothing is redrawn, paint just blits the two halves of
+// the ring in order.
+class SpectrogramImage
+{
+public:
+    static constexpr double historySeconds = 60.0;
+    static constexpr double maxColumnsPerSecond = 30.0;
+    static constexpr int numColumns = (int)(historySeconds * maxColumnsPerSecond);
+
+    SpectrogramImage();
+
+    // Reallocates (and clears) when the height changes
+    void setHeight(int newHeight);
+
+    // Maps rows to bins on the same log axis as the spectrum view
+    void setFrequencyMap(double sampleRate, int numBins);
+
+    // Writes one column from the frame taken at timestamp (samples), given as
+    // magnitudes (full-scale sine = 1.0) or their squares if magnitudesArePower.
+    // The same frame twice, or one too soon after the last column, is ignored.
+    void addFrame(const float* magnitudes, bool magnitudesArePower, juce::int64 timestamp);
+
+    // Audio time between the oldest and the newest column
+    double getHistorySeconds() const noexcept;
+
+    void draw(juce::Graphics& g, juce::Rectangle<int> area) const;
+
+    // Fraction of the height (0 = bottom) where a frequency sits
+    float getFrequencyPosition(float frequency) const noexcept;
+
+    static constexpr float minDb = -100.0f;
+    static constexpr float maxDb = 0.0f;
+
+private:
+    void writeColumn(const float* rowsDb);
+
+    static constexpr int lutSize = 256;
+    static constexpr float lutStepsPerDb = (float)(lutSize - 1) / (maxDb - minDb);
+
+    std::array<juce::PixelARGB, lutSize> colourLut;
+
+    juce::Image image;
+    SpectrumDisplayMap rowMap;      // "columns" of the map are image rows, lowest frequency first
+    std::vector<float> rowValues;   // dB once mapped
+    double mapSampleRate = 0.0;
+    int writeColumnIndex = 0;
+    std::vector<juce::int64> columnTimestamps;  // -1 while a column is still empty
+};
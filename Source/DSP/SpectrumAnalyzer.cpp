@@ -1,65 +1,249 @@
 #include "SpectrumAnalyzer.h"
 
-SpectrumAnalyzer::SpectrumAnalyzer(int order)
-    : fftOrder(order),
+static std::vector<float> makeHannWindow(int size)
+{
+    std::vector<float> window((size_t)size);
+    for (int i = 0; i < size; ++i)
+        window[(size_t)i] = 0.5f * (1.0f - std::cos(2.0f * juce::MathConstants<float>::pi * i / (size - 1)));
+    return window;
+}
+
+SpectrumAnalyzer::SpectrumAnalyzer(int order, int channels)
+    : SpectrumAnalyzer(order, channels, order, order)
+{
+}
+
+SpectrumAnalyzer::SpectrumAnalyzer(int order, int channels, int lowestOrder, int highestOrder)
+    : minOrder(juce::jmin(lowestOrder, order)),
+    maxOrder(juce::jmax(highestOrder, order)),
+    numChannels(juce::jlimit(1, maxChannels, channels)),
+    fftOrder(order),
     fftSize(1 << order),
     hopSize((1 << order) / 4),
-    fft(std::make_unique<juce::dsp::FFT>(order)),
-    fifo(fftSize, 0.0f),
-    fftData(2 * fftSize, 0.0f),
-    magnitude(fftSize / 2, 0.0f),
-    smoothedMagnitude(fftSize / 2, 0.0f)
+    requestedOrder(order),
+    smoothedNumBins((1 << order) / 2)
 {
-    fifoIndex = 0;
-    fifoWrapped = false;
+    // Everything the worker touches is sized for the largest order, so a switch never allocates
+    const int maxSize = 1 << maxOrder;
 
-    // Hann window + RMS normalization
-    hannWindow.resize(fftSize);
-    float sumSquares = 0.0f;
-    for (int i = 0; i < fftSize; ++i)
+    for (int ch = 0; ch < numChannels; ++ch)
     {
-        hannWindow[i] = 0.5f * (1.0f - std::cos(2.0 * juce::MathConstants<float>::pi * i / (fftSize - 1)));
-        sumSquares += hannWindow[i] * hannWindow[i];
+        fifo[ch].assign(maxSize, 0.0f);
+        smoothedMagnitude[ch].assign(maxSize / 2, 0.0f);
     }
-    windowRMS = std::sqrt(sumSquares);
+
+    if (numChannels == 1)
+    {
+        fftData.assign(2 * maxSize, 0.0f);
+    }
+    else
+    {
+        packedTime.assign(maxSize, {});
+        packedSpectrum.assign(maxSize, {});
+    }
+
+    frames.initialise([this, maxSize](Frame& frame)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                frame.magnitude[ch].assign(maxSize / 2, 0.0f);
+
+            if (numChannels > 1)
+            {
+                frame.crossRe.assign(maxSize / 2, 0.0f);
+                frame.crossIm.assign(maxSize / 2, 0.0f);
+            }
+
+            frame.numBins = fftSize / 2;
+        });
+
+    fftPlans.resize((size_t)(maxOrder - minOrder + 1));
+    hannWindows.resize(fftPlans.size());
+
+    fifoIndex = 0;
+    fifoWrapped = false;
 }
 
-void SpectrumAnalyzer::prepareToPlay(double, int)
+void SpectrumAnalyzer::prepareToPlay(double sampleRate, int)
 {
-    const juce::ScopedLock sl(lock);
-    std::fill(fifo.begin(), fifo.end(), 0.0f);
-    std::fill(fftData.begin(), fftData.end(), 0.0f);
-    std::fill(magnitude.begin(), magnitude.end(), 0.0f);
-    std::fill(smoothedMagnitude.begin(), smoothedMagnitude.end(), 0.0f);
+    // Plans and windows depend only on the size, so they survive later prepares
+    for (int order = minOrder; order <= maxOrder; ++order)
+    {
+        const auto index = (size_t)(order - minOrder);
+
+        if (fftPlans[index] == nullptr)
+        {
+            fftPlans[index] = std::make_unique<juce::dsp::FFT>(order);
+            hannWindows[index] = makeHannWindow(1 << order);
+        }
+    }
+
+    useOrder(requestedOrder.load(std::memory_order_relaxed));
+    currentSampleRate = sampleRate;
+
+    // Nothing is held until a mode that needs it is selected; the worker then
+    // sizes the history for that window in applyAveraging()
+    averager.prepare(numChannels, numChannels > 1 ? 2 : 0, maxAveragingSeconds);
+
+    // Enough room for ~100 ms of audio so the worker can sleep between passes
+    ring.prepare(numChannels, juce::jmax(2 * (1 << maxOrder), juce::nextPowerOfTwo((int)(sampleRate * 0.1))));
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        std::fill(fifo[ch].begin(), fifo[ch].end(), 0.0f);
     fifoIndex = 0;
     fifoWrapped = false;
     samplesSinceLastFFT = 0;
+    samplesAnalysed = 0;
+}
+
+void SpectrumAnalyzer::useOrder(int order)
+{
+    const auto index = (size_t)(order - minOrder);
+
+    fftOrder = order;
+    fftSize = 1 << order;
+    hopSize = fftSize / 4;
+    fft = fftPlans[index].get();
+    hannWindow = hannWindows[index].data();
+}
+
+void SpectrumAnalyzer::applyRequestedOrder()
+{
+    const int newOrder = requestedOrder.load(std::memory_order_relaxed);
+    if (newOrder == fftOrder)
+        return;
+
+    // Keep the newest samples, laid out chronologically at the end of the new
+    // history with silence before them, so the next frame is usable straight away
+    const int newSize = 1 << newOrder;
+    const int keep = juce::jmin(fftSize, newSize);
+    const int oldest = (fifoIndex - keep + fftSize) % fftSize;
+    const int firstRun = juce::jmin(keep, fftSize - oldest);
+
+    // The transform buffers are free between frames and hold at least maxSize floats
+    float* scratch = numChannels == 1 ? fftData.data() : reinterpret_cast<float*>(packedTime.data());
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        float* history = fifo[ch].data();
+
+        juce::FloatVectorOperations::copy(scratch, history + oldest, firstRun);
+        juce::FloatVectorOperations::copy(scratch + firstRun, history, keep - firstRun);
+
+        juce::FloatVectorOperations::clear(history, newSize - keep);
+        juce::FloatVectorOperations::copy(history + newSize - keep, scratch, keep);
+    }
+
+    fifoIndex = 0;
+    useOrder(newOrder);
 }
 
 void SpectrumAnalyzer::pushAudioBlock(const float* input, int numSamples)
 {
-    if (!input || numSamples <= 0)
+    pushAudioBlock(input, input, numSamples);
+}
+
+void SpectrumAnalyzer::pushAudioBlock(const float* left, const float* right, int numSamples)
+{
+    if (!left || !right || numSamples <= 0)
         return;
 
-    const juce::ScopedLock sl(lock);
+    const float* inputs[maxChannels] = { left, right };
+    ring.push(inputs, numSamples);
+}
+
+bool SpectrumAnalyzer::serviceAnalysis()
+{
+    if (ring.getNumReady() <= 0)
+        return false;
+
+    ring.read(ring.getNumReady(), [this](const float* const* data, int numSamples)
+        {
+            appendToHistory(data, numSamples);
+        });
 
-    for (int i = 0; i < numSamples; ++i)
+    return true;
+}
+
+void SpectrumAnalyzer::appendToHistory(const float* const* channels, int numSamples)
+{
+    const bool shouldCompute = active.load(std::memory_order_relaxed);
+    const bool resumed = shouldCompute && !computing;
+    computing = shouldCompute;
+
+    // Whatever was averaged before the pause is out of date
+    if (resumed)
+        averager.reset();
+
+    // Averaging has to see every hop; an instantaneous frame only matters if
+    // somebody is going to look at it
+    const bool everyHop = computing
+        && (scheduling.load(std::memory_order_relaxed) == Scheduling::everyHop
+            || averagingMode.load(std::memory_order_relaxed) != AveragingMode::instantaneous);
+
+    // Samples between frames: a hop, or on demand whatever the frame rate
+    // limit asks for on top of that
+    const float frameRateLimit = maxFrameRate.load(std::memory_order_relaxed);
+    auto getFrameSpacing = [this, everyHop, frameRateLimit]
+        {
+            return everyHop || frameRateLimit <= 0.0f
+                       ? hopSize
+                       : juce::jmax(hopSize, juce::roundToInt(currentSampleRate / frameRateLimit));
+        };
+
+    int frameSpacing = getFrameSpacing();
+
+    // Coming from on demand the count may be past a hop
+    samplesSinceLastFFT = juce::jmin(samplesSinceLastFFT, frameSpacing);
+
+    int offset = 0;
+
+    // Copy in contiguous runs that stop at the end of the history or, when
+    // every hop is analysed, at a hop boundary
+    while (numSamples > 0)
     {
-        fifo[fifoIndex++] = input[i];
-        samplesSinceLastFFT++;
+        int run = juce::jmin(numSamples, fftSize - fifoIndex);
+
+        if (everyHop)
+            run = juce::jmin(run, hopSize - samplesSinceLastFFT);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::copy(fifo[ch].data() + fifoIndex, channels[ch] + offset, run);
+
+        offset += run;
+        numSamples -= run;
+        fifoIndex += run;
+        samplesAnalysed += run;
+
+        // Only "the spacing or more" matters between frames, so this stays bounded
+        samplesSinceLastFFT = juce::jmin(samplesSinceLastFFT + run, frameSpacing);
 
         if (fifoIndex >= fftSize)
+        {
             fifoIndex = 0;
+            fifoWrapped = true;
+        }
 
-        if (samplesSinceLastFFT >= hopSize)
+        if (everyHop && samplesSinceLastFFT >= hopSize)
         {
             samplesSinceLastFFT = 0;
-            if (fifoWrapped || fifoIndex >= hopSize)
-                computeFFT();
+            applyRequestedOrder();
+            frameSpacing = getFrameSpacing(); // a new size brings a new hop
+            computeFFT();
         }
+    }
 
-        if (fifoIndex == 0)
-            fifoWrapped = true;
+    // On demand: one frame from the newest samples once the spacing has passed
+    // since the last one, so a requested frame is never older than the ring
+    // latency and never more frequent than the hop rate or the frame rate limit.
+    // After a pause the history kept up: show it now rather than a hop later.
+    const bool requestDue = computing && !everyHop && samplesSinceLastFFT >= frameSpacing
+                            && frameRequested.exchange(false, std::memory_order_relaxed);
+
+    if (resumed || requestDue)
+    {
+        samplesSinceLastFFT = 0;
+        applyRequestedOrder();
+        computeFFT();
     }
 }
 
@@ -68,61 +252,173 @@ void SpectrumAnalyzer::computeFFT()
     if (!fifoWrapped)
         return;
 
-    // Copy latest fftSize samples in chronological order
-    for (int i = 0; i < fftSize; ++i)
-        fftData[i] = fifo[(fifoIndex + i) % fftSize];
+   #if YAAA_PROFILE_SPECTRUM
+    frameCounter.start();
+   #endif
 
-    // Remove DC / mean
-    float mean = 0.0f;
-    for (int i = 0; i < fftSize; ++i)
-        mean += fftData[i];
-    mean /= fftSize;
-    for (int i = 0; i < fftSize; ++i)
-        fftData[i] -= mean;
+    // Only fails if the GUI pins more frames than the pool holds; drop this one then
+    auto* target = frames.getFreeFrame();
+    if (target == nullptr)
+        return;
 
-    // Apply Hann window
-    for (int i = 0; i < fftSize; ++i)
-        fftData[i] *= hannWindow[i];
+    auto& frame = *target;
+    frame.scale = magnitudeScale.load(std::memory_order_relaxed);
+    frame.numBins = fftSize / 2;
 
-    // FFT
-    fft->performRealOnlyForwardTransform(fftData.data());
+    if (numChannels == 1)
+        computeMonoFFT(frame);
+    else
+        computeStereoFFT(frame);
+
+    applyAveraging(frame);
+
+    if (frame.scale == MagnitudeScale::linear)
+        for (int ch = 0; ch < numChannels; ++ch)
+            SpectrumKernels::squareRoot(frame.magnitude[ch].data(), frame.numBins);
+
+    frames.publish(target, samplesAnalysed);
+
+   #if YAAA_PROFILE_SPECTRUM
+    frameCounter.stop();
+   #endif
+}
+
+void SpectrumAnalyzer::computeMonoFFT(Frame& frame)
+{
+    // Mean removal, chronological unroll and Hann window in one pass
+    const float mean = SpectrumKernels::mean(fifo[0].data(), fftSize);
+    SpectrumKernels::unrollWindowed(fftData.data(), fifo[0].data(), fifoIndex, fftSize, hannWindow, mean);
+
+    fft->performRealOnlyForwardTransform(fftData.data(), true);
 
     const int numBins = fftSize / 2;
+    const float scale = 2.0f / (fftSize * 0.5f); // full-scale sine = 1.0
 
-    // Linear magnitude, full-scale normalized
+    auto& magnitude = frame.magnitude[0];
+    SpectrumKernels::power(magnitude.data(), fftData.data(), scale * scale, numBins);
     magnitude[0] = 0.0f; // DC removed
+}
+
+void SpectrumAnalyzer::computeStereoFFT(Frame& frame)
+{
+    // Pack L into the real part and R into the imaginary part, in chronological order
+    const float meanL = SpectrumKernels::mean(fifo[0].data(), fftSize);
+    const float meanR = SpectrumKernels::mean(fifo[1].data(), fftSize);
+    SpectrumKernels::unrollWindowedPacked(reinterpret_cast<float*>(packedTime.data()),
+                                          fifo[0].data(), fifo[1].data(), fifoIndex, fftSize,
+                                          hannWindow, meanL, meanR);
+
+    fft->perform(packedTime.data(), packedSpectrum.data(), false);
+
+    // Z[k] = X[k] + jY[k], with X and Y the spectra of the two real inputs:
+    //   X[k] = (Z[k] + conj(Z[N-k])) / 2
+    //   Y[k] = (Z[k] - conj(Z[N-k])) / 2j
+    const int numBins = fftSize / 2;
+    const float scale = 2.0f / (fftSize * 0.5f); // full-scale sine = 1.0
+    const float halfScale = 0.5f * scale;
+
+    auto* powerL = frame.magnitude[0].data();
+    auto* powerR = frame.magnitude[1].data();
 
     for (int bin = 1; bin < numBins; ++bin)
     {
-        float re = fftData[2 * bin];
-        float im = fftData[2 * bin + 1];
-        float magLinear = 2.0f * std::sqrt(re * re + im * im) / (fftSize * 0.5f); // full-scale sine = 1.0
-        magnitude[bin] = magLinear;
+        const auto z = packedSpectrum[bin];
+        const auto zMirror = std::conj(packedSpectrum[fftSize - bin]);
+
+        const auto sum = z + zMirror;   // 2X
+        const auto diff = z - zMirror;  // 2jY
+
+        const float xRe = sum.real() * halfScale;
+        const float xIm = sum.imag() * halfScale;
+        const float yRe = diff.imag() * halfScale;
+        const float yIm = -diff.real() * halfScale;
+
+        powerL[bin] = xRe * xRe + xIm * xIm;
+        powerR[bin] = yRe * yRe + yIm * yIm;
+
+        // X * conj(Y)
+        frame.crossRe[bin] = xRe * yRe + xIm * yIm;
+        frame.crossIm[bin] = xIm * yRe - xRe * yIm;
     }
+
+    powerL[0] = powerR[0] = 0.0f; // DC removed
+    frame.crossRe[0] = frame.crossIm[0] = 0.0f;
 }
 
-void SpectrumAnalyzer::updateSmoothedMagnitudes()
+void SpectrumAnalyzer::applyAveraging(Frame& frame)
 {
-    const juce::ScopedLock sl(lock);
-    const int numBins = (int)magnitude.size();
+    const auto mode = averagingMode.load(std::memory_order_relaxed);
+    const float seconds = averagingSeconds.load(std::memory_order_relaxed);
 
-    for (int i = 0; i < numBins; ++i)
+    // Reconfiguring may allocate the sliding-window history, which is fine here on the worker
+    if (mode != appliedAveragingMode || seconds != appliedAveragingSeconds || frame.numBins != averager.getNumBins())
     {
-        float freqRatio = (float)i / (float)numBins;
-        float release = juce::jmap(freqRatio, 0.0f, 1.0f, releaseLow, releaseHigh);
+        averager.configure(mode, seconds, frame.numBins, currentSampleRate / hopSize);
+        appliedAveragingMode = mode;
+        appliedAveragingSeconds = seconds;
+    }
 
-        float input = magnitude[i];
-        float prev = smoothedMagnitude[i];
+    float* planes[] = { frame.magnitude[0].data(), nullptr, nullptr, nullptr };
 
-        if (input > prev)
-            smoothedMagnitude[i] = attack * input + (1.0f - attack) * prev;
-        else
-            smoothedMagnitude[i] = release * input + (1.0f - release) * prev;
+    if (numChannels > 1)
+    {
+        planes[1] = frame.magnitude[1].data();
+        planes[2] = frame.crossRe.data();
+        planes[3] = frame.crossIm.data();
     }
+
+    averager.process(planes);
+    frame.averaging = averager.getMode();
 }
 
-std::vector<float> SpectrumAnalyzer::getMagnitudesCopy() const
+void SpectrumAnalyzer::updateSmoothedMagnitudes()
 {
-    const juce::ScopedLock sl(lock);
-    return smoothedMagnitude; // linear, ready for dB conversion at paint
-}
\ No newline at end of file
+    const auto& frame = *acquireLatestFrame();
+
+    const int numBins = frame.numBins;
+
+    // A new FFT size or scale changes what every bin means, so restart the smoothing from this frame
+    if (numBins != smoothedNumBins || frame.scale != smoothedScale)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            std::copy_n(frame.magnitude[ch].begin(), numBins, smoothedMagnitude[ch].begin());
+
+        smoothedNumBins = numBins;
+        smoothedScale = frame.scale;
+    }
+
+    // Averaged frames are already smoothed in audio time; GUI-rate ballistics on
+    // top would make the result depend on the repaint rate again
+    if (frame.averaging != AveragingMode::instantaneous)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            std::copy_n(frame.magnitude[ch].begin(), numBins, smoothedMagnitude[ch].begin());
+
+        return;
+    }
+
+    const bool power = frame.scale == MagnitudeScale::power;
+    const float binAttack = power ? toPowerCoefficient(attack) : attack;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto& magnitude = frame.magnitude[ch];
+        auto& smoothed = smoothedMagnitude[ch];
+
+        for (int i = 0; i < numBins; ++i)
+        {
+            float freqRatio = (float)i / (float)numBins;
+            float release = juce::jmap(freqRatio, 0.0f, 1.0f, releaseLow, releaseHigh);
+            if (power)
+                release = toPowerCoefficient(release);
+
+            float input = magnitude[i];
+            float prev = smoothed[i];
+
+            if (input > prev)
+                smoothed[i] = binAttack * input + (1.0f - binAttack) * prev;
+            else
+                smoothed[i] = release * input + (1.0f - release) * prev;
+        }
+    }
+}
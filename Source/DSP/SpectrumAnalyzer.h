@@ -2,45 +2,226 @@
 
 #include <JuceHeader.h>
 #include <juce_dsp/juce_dsp.h>
+#include <atomic>
+#include "AnalysisWorker.h"
+#include "AnalysisFramePool.h"
+#include "SampleRing.h"
+#include "SpectrumKernels.h"
+#include "SpectrumAverager.h"
 
-// Simple thread-safe spectrum analyzer that maintains a circular FIFO,
-// produces an FFT when a full frame is available, and exposes a thread-safe
-// copy API for magnitudes for the GUI.
-class SpectrumAnalyzer
+// Set to 1 to log the average cost of one analysis frame (window + FFT + magnitude)
+#ifndef YAAA_PROFILE_SPECTRUM
+ #define YAAA_PROFILE_SPECTRUM 0
+#endif
+
+// Spectrum analyzer split across two threads. The audio thread only appends
+// samples to a lock-free ring; the analysis worker drains that ring into the
+// circular FFT history and produces an FFT every hop. Finished magnitude frames
+// come from a small pool of reference-counted frames and are published through
+// a triple buffer, so the GUI never blocks or allocates and can pin a frame
+// (freeze, snapshots) without copying it.
+//
+// In stereo mode both channels share the ring, history bookkeeping and window,
+// and are packed into a single complex FFT (L real, R imaginary). The two spectra
+// are separated afterwards, which also gives the L/R cross-spectrum for free.
+//
+// The FFT size can be switched at runtime within the range given to the
+// constructor. Every FFT plan and window in that range is built up front in
+// prepareToPlay, so a switch is just a pointer swap done by the worker at the
+// next hop boundary.
+//
+// Averaging over time (exponential or sliding window) also runs on the worker,
+// in the power domain and before any conversion to linear magnitude.
+//
+// Frames are produced either every hop (Scheduling::everyHop) or on demand:
+// the worker then only keeps the history up to date and transforms the newest
+// fftSize samples after a consumer asks for a frame, at most once per hop and
+// no more often than the display's frame rate (setMaxFrameRate). The cost
+// follows how often the spectrum is looked at (nothing while frozen or hidden)
+// instead of the sample rate. Time averaging needs every hop, so it switches
+// back to hop-rate frames for as long as it is on.
+//
+// While nobody needs the output (setActive(false)) the worker still copies
+// samples into the history, which costs next to nothing, but skips the FFTs.
+// Switching back on restarts the average and computes a frame straight away
+// from the history, so a view that comes back has a valid spectrum at once.
+class SpectrumAnalyzer : public AnalysisWorker::Client
 {
 public:
-    SpectrumAnalyzer(int fftOrder = 14); // 16384 FFT by default
-    ~SpectrumAnalyzer() = default;
+    static constexpr int maxChannels = 2;
+
+    // Range of the user-facing resolution setting (1024 .. 65536 points)
+    static constexpr int minFFTOrder = 10;
+    static constexpr int maxFFTOrder = 16;
+
+    // linear: full-scale sine = 1.0. power: the square of that, which saves the
+    // per-bin sqrt when the consumer converts straight to dB (10 * log10).
+    enum class MagnitudeScale { linear, power };
+
+    // A one-pole step keeping (1 - c) of a power value moves half as many dB as
+    // the same step on a magnitude. Smoothing power with this coefficient
+    // instead gives the ballistics c would give on linear magnitudes.
+    static constexpr float toPowerCoefficient(float magnitudeCoefficient) noexcept
+    {
+        return magnitudeCoefficient * (2.0f - magnitudeCoefficient);
+    }
+
+    using AveragingMode = SpectrumAverager::Mode;
+
+    enum class Scheduling { everyHop, onDemand };
+
+    struct Frame
+    {
+        std::vector<float> magnitude[maxChannels];
+        std::vector<float> crossRe;                // L * conj(R), always power scale (stereo only)
+        std::vector<float> crossIm;
+        MagnitudeScale scale = MagnitudeScale::linear;
+        int numBins = 0;                           // valid bins; the vectors are sized for the largest FFT
+        AveragingMode averaging = AveragingMode::instantaneous;
+    };
+
+    using FramePtr = AnalysisFramePool<Frame>::Ptr;
+
+    SpectrumAnalyzer(int fftOrder = 14, int numChannels = 1); // 16384 FFT by default, fixed size
+    SpectrumAnalyzer(int fftOrder, int numChannels, int minOrder, int maxOrder);
+    ~SpectrumAnalyzer() override = default;
+
+    // Call while the analysis worker is stopped. Builds any missing FFT plans
+    // and windows for the whole order range.
+    void prepareToPlay(double sampleRate, int samplesPerBlock);
+
+    // Longest sliding window prepareToPlay should make room for. Call before
+    // prepareToPlay; without it slidingWindow falls back to exponential.
+    void setMaxAveragingTime(double seconds) noexcept { maxAveragingSeconds = seconds; }
+
+    // Any thread. Takes effect from the next frame and restarts the average.
+    void setAveraging(AveragingMode mode, float seconds) noexcept
+    {
+        averagingMode.store(mode, std::memory_order_relaxed);
+        averagingSeconds.store(seconds, std::memory_order_relaxed);
+    }
+
+    // Any thread, lock- and allocation-free. The worker picks the new size up at
+    // the next hop boundary; orders outside the constructor's range are clamped.
+    void setFFTOrder(int newOrder) noexcept { requestedOrder.store(juce::jlimit(minOrder, maxOrder, newOrder), std::memory_order_relaxed); }
+
+    // Any thread, takes effect with the next samples the worker receives
+    void setScheduling(Scheduling newScheduling) noexcept { scheduling.store(newScheduling, std::memory_order_relaxed); }
+
+    // Any thread. On demand, frames are at least this far apart in audio time
+    // (and always at least a hop); 0 for no limit beyond the hop rate.
+    void setMaxFrameRate(float framesPerSecond) noexcept { maxFrameRate.store(framesPerSecond, std::memory_order_relaxed); }
+
+    // Any thread. On demand, asks for a frame from the newest samples; it is
+    // published as soon as the worker has a hop's worth of new input.
+    // updateSmoothedMagnitudes() asks for the next frame by itself.
+    void requestFrame() noexcept { frameRequested.store(true, std::memory_order_relaxed); }
 
-    void prepareToPlay(double sampleRate, int numChannels);
+    // Any thread. The worker picks it up with the next samples it receives.
+    void setActive(bool shouldBeActive) noexcept { active.store(shouldBeActive, std::memory_order_relaxed); }
+
+    // Audio thread: bounded copy into the ring, never blocks
     void pushAudioBlock(const float* input, int numSamples);
+    void pushAudioBlock(const float* left, const float* right, int numSamples);
+
+    // Worker thread
+    bool serviceAnalysis() override;
+
+    // GUI thread: picks up the newest published frame, smooths it and asks
+    // for the next one. The smoothed values keep the scale of the frames.
     void updateSmoothedMagnitudes();
-    std::vector<float> getMagnitudesCopy() const;
+    const std::vector<float>& getSmoothedMagnitudes(int channel = 0) const noexcept { return smoothedMagnitude[channel]; }
+    MagnitudeScale getSmoothedScale() const noexcept { return smoothedScale; }
+    const FramePtr& getLatestFrame() const noexcept { return frames.getLatest(); }
+
+    // GUI thread: the same without smoothing, for owners that smooth later on
+    const FramePtr& acquireLatestFrame() noexcept
+    {
+        requestFrame();
+        frames.acquire();
+        return frames.getLatest();
+    }
+
+    // Takes effect from the next frame
+    void setMagnitudeScale(MagnitudeScale newScale) noexcept { magnitudeScale.store(newScale, std::memory_order_relaxed); }
+
+    int getNumChannels() const noexcept { return numChannels; }
+
+    // Bins of the frame last picked up by updateSmoothedMagnitudes() (GUI thread)
+    int getNumBins() const noexcept { return smoothedNumBins; }
+
+    // Samples the audio thread had to drop because the worker fell behind
+    int getNumDroppedSamples() const noexcept { return ring.getNumDroppedSamples(); }
+
+    // Worker thread: feeds samples straight into the FFT history, bypassing the
+    // ring. Used by owners that produce their input on the worker themselves.
+    void appendToHistory(const float* const* channels, int numSamples);
 
 private:
     void computeFFT();
-    
-    mutable juce::CriticalSection lock;
+    void computeMonoFFT(Frame& frame);
+    void computeStereoFFT(Frame& frame);
+    void useOrder(int order);
+    void applyRequestedOrder();
+    void applyAveraging(Frame& frame);
+
+    const int minOrder;
+    const int maxOrder;
+    const int numChannels;
+
+    // Current size, owned by the worker
+    int fftOrder;
+    int fftSize;
+    int hopSize;
+
+    // audio thread -> worker
+    SampleRing ring;
+    std::atomic<MagnitudeScale> magnitudeScale{ MagnitudeScale::linear };
+    std::atomic<int> requestedOrder;
+    std::atomic<AveragingMode> averagingMode{ AveragingMode::instantaneous };
+    std::atomic<float> averagingSeconds{ 1.0f };
+    std::atomic<bool> active{ true };
+    std::atomic<Scheduling> scheduling{ Scheduling::everyHop };
+    std::atomic<bool> frameRequested{ false };
+    std::atomic<float> maxFrameRate{ 0.0f };
 
-    const int fftOrder;
-    const int fftSize;
-    const int hopSize;
+    // One plan and window per order in [minOrder, maxOrder]
+    std::vector<std::unique_ptr<juce::dsp::FFT>> fftPlans;
+    std::vector<std::vector<float>> hannWindows;
+    juce::dsp::FFT* fft = nullptr;
+    const float* hannWindow = nullptr;
 
-    std::unique_ptr<juce::dsp::FFT> fft;
-    std::vector<float> fifo;
-    std::vector<float> fftData;
-    std::vector<float> magnitude;          // linear FFT magnitude
-    std::vector<float> smoothedMagnitude;  // linear, smoothed
+    // Sized for the largest order; only the first fftSize entries are in use
+    std::vector<float> fifo[maxChannels];
+    std::vector<float> fftData;                             // mono: real-only transform
+    std::vector<juce::dsp::Complex<float>> packedTime;      // stereo: L + jR
+    std::vector<juce::dsp::Complex<float>> packedSpectrum;
 
-    std::vector<float> hannWindow;
-    float windowRMS = 1.0f;
+    SpectrumAverager averager;
+    AveragingMode appliedAveragingMode = AveragingMode::instantaneous;
+    float appliedAveragingSeconds = 0.0f;
+    double maxAveragingSeconds = 0.0;
+    double currentSampleRate = 44100.0;
+
+    // worker -> GUI
+    AnalysisFramePool<Frame> frames;
+
+    std::vector<float> smoothedMagnitude[maxChannels];  // smoothed, in smoothedScale (GUI thread only)
+    int smoothedNumBins;
+    MagnitudeScale smoothedScale = MagnitudeScale::linear;
 
     int fifoIndex = 0;
     bool fifoWrapped = false;
-    int samplesSinceLastFFT = 0;
+    int samplesSinceLastFFT = 0;       // capped at the frame spacing
+    juce::int64 samplesAnalysed = 0;   // frame timestamps
+    bool computing = true;             // worker's view of active
+
+   #if YAAA_PROFILE_SPECTRUM
+    juce::PerformanceCounter frameCounter{ "SpectrumAnalyzer frame", 500 };
+   #endif
 
     // SPAN-style smoothing parameters
     float attack = 0.6f;   // fast attack
     float releaseLow = 0.05f;   // low freq release
     float releaseHigh = 0.4f;   // high freq release
-};
\ No newline at end of file
+};
@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    SpectrumAverager.cpp
+    Created: 15 Oct 2026 5:32:14pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#include "SpectrumAverager.h"
+
+// Sized exactly, or given back entirely when the mode doesn't use it
+static void resizeOrRelease(std::vector<float>& buffer, size_t size)
+{
+    if (size == 0)
+        std::vector<float>().swap(buffer);
+    else
+        buffer.assign(size, 0.0f);
+}
+
+void SpectrumAverager::prepare(int powerPlanes, int crossPlanes, double maxSeconds)
+{
+    numPowerPlanes = powerPlanes;
+    numPlanes = powerPlanes + crossPlanes;
+    maxWindowSeconds = juce::jmax(0.0, maxSeconds);
+
+    for (auto* buffer : { &state, &runningSum, &freshSum, &history })
+        resizeOrRelease(*buffer, 0);
+
+    // forces the owner to configure() before the next frame
+    mode = Mode::instantaneous;
+    numBins = 0;
+    reset();
+}
+
+void SpectrumAverager::configure(Mode newMode, double seconds, int newNumBins, double framesPerSecond)
+{
+    mode = newMode;
+    numBins = newNumBins;
+
+    const double frames = juce::jmax(1.0, seconds * framesPerSecond);
+    alpha = (float)(1.0 - std::exp(-1.0 / frames));
+
+    const int maxFrames = (int)std::ceil(maxWindowSeconds * framesPerSecond);
+
+    // without history the closest thing is an exponential average of the same length
+    if (mode == Mode::slidingWindow && maxFrames < 1)
+        mode = Mode::exponential;
+
+    windowFrames = juce::jlimit(1, juce::jmax(1, maxFrames), juce::roundToInt(frames));
+
+    const auto frameSize = (size_t)numPlanes * (size_t)juce::jmax(0, numBins);
+    const bool sliding = mode == Mode::slidingWindow;
+
+    resizeOrRelease(state, mode == Mode::exponential ? frameSize : 0);
+    resizeOrRelease(runningSum, sliding ? frameSize : 0);
+    resizeOrRelease(freshSum, sliding ? frameSize : 0);
+    resizeOrRelease(history, sliding ? (size_t)windowFrames * frameSize : 0);
+
+    reset();
+}
+
+void SpectrumAverager::reset() noexcept
+{
+    primed = false;
+    writeSlot = 0;
+    numFilled = 0;
+
+    std::fill(runningSum.begin(), runningSum.end(), 0.0f);
+    std::fill(freshSum.begin(), freshSum.end(), 0.0f);
+}
+
+void SpectrumAverager::process(float* const* planes) noexcept
+{
+    if (mode == Mode::instantaneous || numBins <= 0)
+        return;
+
+    if (mode == Mode::exponential)
+    {
+        for (int p = 0; p < numPlanes; ++p)
+        {
+            float* average = state.data() + p * numBins;
+
+            // start from the first frame rather than fading in from silence
+            if (primed)
+            {
+                juce::FloatVectorOperations::multiply(average, 1.0f - alpha, numBins);
+                juce::FloatVectorOperations::addWithMultiply(average, planes[p], alpha, numBins);
+            }
+            else
+            {
+                juce::FloatVectorOperations::copy(average, planes[p], numBins);
+            }
+
+            juce::FloatVectorOperations::copy(planes[p], average, numBins);
+        }
+
+        primed = true;
+        return;
+    }
+
+    const bool full = numFilled == windowFrames;
+    const float scale = 1.0f / (float)(full ? windowFrames : numFilled + 1);
+
+    for (int p = 0; p < numPlanes; ++p)
+    {
+        float* sum = runningSum.data() + p * numBins;
+        float* stored = slot(writeSlot, p);
+        float* frame = planes[p];
+
+        if (full)
+            juce::FloatVectorOperations::subtract(sum, stored, numBins);
+
+        juce::FloatVectorOperations::copy(stored, frame, numBins);
+        juce::FloatVectorOperations::add(sum, frame, numBins);
+        juce::FloatVectorOperations::add(freshSum.data() + p * numBins, frame, numBins);
+
+        juce::FloatVectorOperations::multiply(frame, sum, scale, numBins);
+
+        // the subtraction can leave power a hair below zero once a loud frame leaves the window
+        if (p < numPowerPlanes)
+            juce::FloatVectorOperations::max(frame, frame, 0.0f, numBins);
+    }
+
+    numFilled = juce::jmin(numFilled + 1, windowFrames);
+
+    // freshSum now holds exactly the frames in the ring
+    if (++writeSlot == windowFrames)
+    {
+        writeSlot = 0;
+        std::copy_n(freshSum.begin(), numPlanes * numBins, runningSum.begin());
+        std::fill_n(freshSum.begin(), numPlanes * numBins, 0.0f);
+    }
+}
@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    SpectrumAverager.h
+    Created: 15 Oct 2026 5:32:14pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Averages consecutive spectrum frames in the power domain, once per hop on the
+// analysis worker, so the time constants are in seconds of audio rather than
+// GUI repaints.
+//
+// A frame is a set of planes of numBins values each: first the power planes
+// (one per channel, never negative), then any cross-spectrum planes (signed).
+//
+//  - exponential:   avg += (1 - e^(-hop / tau)) * (x - avg)
+//  - slidingWindow: plain mean of the last N frames. The frames are kept in a
+//    ring with a running sum, so a hop costs O(bins) whatever the window length.
+//    A second sum is rebuilt from scratch over every pass through the ring and
+//    replaces the running one when the ring wraps, which throws away whatever
+//    rounding error the add/subtract pairs collected, so it can't drift.
+//
+// Memory follows the selected mode: nothing for instantaneous, one frame for
+// exponential, and for a sliding window just the frames that window covers
+// (about 2 * sampleRate * seconds values per plane at any FFT size). It is
+// allocated by configure(), which the owner calls from its analysis thread.
+class SpectrumAverager
+{
+public:
+    enum class Mode { instantaneous, exponential, slidingWindow };
+
+    // Releases any history. maxWindowSeconds bounds the sliding window; 0
+    // leaves only the exponential mode.
+    void prepare(int numPowerPlanes, int numCrossPlanes, double maxWindowSeconds);
+
+    // Restarts the average; framesPerSecond is the hop rate. Allocates (or
+    // frees) what the new mode needs, so keep it off the audio thread.
+    void configure(Mode newMode, double seconds, int newNumBins, double framesPerSecond);
+
+    // Averages the planes in place
+    void process(float* const* planes) noexcept;
+
+    void reset() noexcept;
+
+    Mode getMode() const noexcept { return mode; }
+    int getNumBins() const noexcept { return numBins; }
+
+private:
+    float* slot(int index, int plane) noexcept { return history.data() + ((size_t)index * (size_t)numPlanes + (size_t)plane) * (size_t)numBins; }
+
+    int numPowerPlanes = 0;
+    int numPlanes = 0;
+
+    Mode mode = Mode::instantaneous;
+    int numBins = 0;
+
+    // exponential
+    float alpha = 1.0f;
+    bool primed = false;
+    std::vector<float> state;          // numPlanes x numBins
+
+    // sliding window
+    std::vector<float> history;        // windowFrames slots of numPlanes x numBins
+    std::vector<float> runningSum;     // numPlanes x numBins
+    std::vector<float> freshSum;
+    double maxWindowSeconds = 0.0;
+    int windowFrames = 1;
+    int writeSlot = 0;
+    int numFilled = 0;
+};
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    SpectrumDisplayMap.cpp
+    Created: 15 Oct 2026 4:47:33pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#include "SpectrumDisplayMap.h"
+
+void SpectrumDisplayMap::build(int numColumns, double sampleRate, int numBins, float minFrequency)
+{
+    columns.assign((size_t)juce::jmax(0, numColumns), {});
+    builtSampleRate = sampleRate;
+    builtNumBins = numBins;
+
+    if (numColumns < 2 || sampleRate <= 0.0 || numBins < 3)
+        return;
+
+    const double nyquist = sampleRate * 0.5;
+    const double binWidth = nyquist / numBins;
+    const double logMin = std::log10((double)minFrequency);
+    const double logMax = std::log10(nyquist);
+
+    auto frequencyOf = [&](double column)
+        {
+            return std::pow(10.0, logMin + column / (numColumns - 1) * (logMax - logMin));
+        };
+
+    for (int x = 0; x < numColumns; ++x)
+    {
+        auto& c = columns[x];
+        c.frequency = (float)frequencyOf(x);
+
+        const double lo = frequencyOf(x - 0.5) / binWidth;
+        const double hi = frequencyOf(x + 0.5) / binWidth;
+
+        c.firstBin = juce::jlimit(1, numBins - 1, (int)std::ceil(lo));
+        c.lastBin = juce::jlimit(1, numBins - 1, (int)std::floor(hi));
+
+        if (c.lastBin <= c.firstBin)
+        {
+            const double bin = juce::jlimit(1.0, (double)(numBins - 2), c.frequency / binWidth);
+            c.firstBin = c.lastBin = (int)bin;
+            c.frac = (float)(bin - c.firstBin);
+        }
+        else
+        {
+            c.frac = 0.0f;
+        }
+    }
+}
+
+bool SpectrumDisplayMap::matches(int numColumns, double sampleRate, int numBins) const noexcept
+{
+    return numColumns == (int)columns.size() && sampleRate == builtSampleRate && numBins == builtNumBins;
+}
+
+void SpectrumDisplayMap::apply(const float* bins, float* out, Aggregation aggregation, bool valuesArePower) const noexcept
+{
+    const int numColumns = (int)columns.size();
+
+    for (int x = 0; x < numColumns; ++x)
+    {
+        const auto& c = columns[x];
+
+        if (c.firstBin == c.lastBin)
+        {
+            out[x] = juce::jmap(c.frac, bins[c.firstBin], bins[c.firstBin + 1]);
+            continue;
+        }
+
+        if (aggregation == Aggregation::max)
+        {
+            float peak = bins[c.firstBin];
+            for (int bin = c.firstBin + 1; bin <= c.lastBin; ++bin)
+                peak = juce::jmax(peak, bins[bin]);
+            out[x] = peak;
+        }
+        else
+        {
+            float sum = 0.0f;
+            for (int bin = c.firstBin; bin <= c.lastBin; ++bin)
+                sum += valuesArePower ? bins[bin] : bins[bin] * bins[bin];
+
+            const float mean = sum / (float)(c.lastBin - c.firstBin + 1);
+            out[x] = valuesArePower ? mean : std::sqrt(mean);
+        }
+    }
+}
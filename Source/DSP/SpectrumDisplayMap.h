@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    SpectrumDisplayMap.h
+    Created: 15 Oct 2026 4:47:33pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Precomputed mapping from display columns on a log-frequency axis to FFT bins.
+//
+// Each column owns the range of bins between its neighbours' midpoints. When a
+// column is narrower than a bin (the lows) it interpolates between the two
+// nearest bins instead; when it spans several bins (the highs) they are
+// aggregated, so narrow peaks can't fall between two sampled bins.
+//
+// Building allocates and does the log/pow work, so only rebuild when the width,
+// sample rate or FFT size changes (see matches()).
+class SpectrumDisplayMap
+{
+public:
+    enum class Aggregation
+    {
+        max,    // keeps peaks, what the spectrum line wants
+        energy  // mean power of the covered bins
+    };
+
+    void build(int numColumns, double sampleRate, int numBins, float minFrequency = 20.0f);
+    bool matches(int numColumns, double sampleRate, int numBins) const noexcept;
+
+    // columns must hold getNumColumns() values. valuesArePower tells the energy
+    // aggregation whether bins hold power or linear magnitude.
+    void apply(const float* bins, float* columns, Aggregation aggregation, bool valuesArePower = false) const noexcept;
+
+    int getNumColumns() const noexcept { return (int)columns.size(); }
+    float getColumnFrequency(int column) const noexcept { return columns[column].frequency; }
+
+    struct Column
+    {
+        int firstBin = 0;         // bins [firstBin, lastBin] belong to this column
+        int lastBin = 0;
+        float frac = 0.0f;        // interpolation weight towards firstBin + 1 when firstBin == lastBin
+        float frequency = 0.0f;   // centre frequency
+    };
+
+    const Column& getColumn(int column) const noexcept { return columns[column]; }
+
+private:
+    std::vector<Column> columns;
+    double builtSampleRate = 0.0;
+    int builtNumBins = 0;
+};
@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    SpectrumKernels.cpp
+    Created: 15 Oct 2026 1:26:18pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#include "SpectrumKernels.h"
+
+namespace SpectrumKernels
+{
+    float sum(const float* data, int numSamples) noexcept
+    {
+        float acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+        float acc4 = 0.0f, acc5 = 0.0f, acc6 = 0.0f, acc7 = 0.0f;
+
+        int i = 0;
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            acc0 += data[i];
+            acc1 += data[i + 1];
+            acc2 += data[i + 2];
+            acc3 += data[i + 3];
+            acc4 += data[i + 4];
+            acc5 += data[i + 5];
+            acc6 += data[i + 6];
+            acc7 += data[i + 7];
+        }
+
+        for (; i < numSamples; ++i)
+            acc0 += data[i];
+
+        return ((acc0 + acc4) + (acc1 + acc5)) + ((acc2 + acc6) + (acc3 + acc7));
+    }
+
+    static void windowSegment(float* dest, const float* src, const float* window, float offset, int n) noexcept
+    {
+        for (int i = 0; i < n; ++i)
+            dest[i] = (src[i] - offset) * window[i];
+    }
+
+    void unrollWindowed(float* dest, const float* history, int start, int size,
+                        const float* window, float offset) noexcept
+    {
+        const int firstLength = size - start;
+
+        windowSegment(dest, history + start, window, offset, firstLength);
+        windowSegment(dest + firstLength, history, window + firstLength, offset, start);
+    }
+
+    static void windowSegmentPacked(float* dest, const float* srcL, const float* srcR, const float* window,
+                                    float offsetL, float offsetR, int n) noexcept
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            dest[2 * i] = (srcL[i] - offsetL) * window[i];
+            dest[2 * i + 1] = (srcR[i] - offsetR) * window[i];
+        }
+    }
+
+    void unrollWindowedPacked(float* destInterleaved, const float* historyL, const float* historyR,
+                              int start, int size, const float* window,
+                              float offsetL, float offsetR) noexcept
+    {
+        const int firstLength = size - start;
+
+        windowSegmentPacked(destInterleaved, historyL + start, historyR + start, window,
+                            offsetL, offsetR, firstLength);
+        windowSegmentPacked(destInterleaved + 2 * firstLength, historyL, historyR, window + firstLength,
+                            offsetL, offsetR, start);
+    }
+
+    void power(float* dest, const float* interleaved, float scale, int numBins) noexcept
+    {
+        for (int k = 0; k < numBins; ++k)
+        {
+            const float re = interleaved[2 * k];
+            const float im = interleaved[2 * k + 1];
+            dest[k] = scale * (re * re + im * im);
+        }
+    }
+
+    void squareRoot(float* data, int numBins) noexcept
+    {
+        for (int k = 0; k < numBins; ++k)
+            data[k] = std::sqrt(data[k]);
+    }
+}
@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+    SpectrumKernels.h
+    Created: 15 Oct 2026 1:26:18pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Inner loops of the spectrum frame pipeline. Every kernel walks contiguous
+// memory with no per-sample modulo or branches, so the compiler can vectorise
+// them for whatever target the plugin is built for (SSE/AVX on x64, NEON on arm).
+namespace SpectrumKernels
+{
+    // Sum of a contiguous range. Uses independent partial sums so the additions
+    // can be spread across SIMD lanes.
+    float sum(const float* data, int numSamples) noexcept;
+
+    // Sum of a whole circular buffer (order does not matter for a sum)
+    inline float mean(const float* history, int size) noexcept { return sum(history, size) / (float)size; }
+
+    // dest[i] = (history[(start + i) % size] - offset) * window[i]
+    // done as two contiguous segments: [start, size) then [0, start).
+    void unrollWindowed(float* dest, const float* history, int start, int size,
+                        const float* window, float offset) noexcept;
+
+    // Same as unrollWindowed, but writes two channels interleaved as complex
+    // values (left real, right imaginary) for a packed stereo transform.
+    void unrollWindowedPacked(float* destInterleaved, const float* historyL, const float* historyR,
+                              int start, int size, const float* window,
+                              float offsetL, float offsetR) noexcept;
+
+    // dest[k] = scale * (re^2 + im^2) for an interleaved complex spectrum
+    void power(float* dest, const float* interleaved, float scale, int numBins) noexcept;
+
+    // dest[k] = sqrt(dest[k]), in place
+    void squareRoot(float* data, int numBins) noexcept;
+}
@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    StereoKernels.cpp
+    Created: 15 Oct 2026 8:47:52pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#include "StereoKernels.h"
+
+namespace StereoKernels
+{
+    // Double accumulators: the correlation meter subtracts these sums from
+    // running totals, where float rounding on a loud run would swamp a quiet window
+    static constexpr int lanes = 4;
+
+    Sums measure(const float* left, const float* right, int numSamples) noexcept
+    {
+        double ll[lanes] = {}, rr[lanes] = {}, lr[lanes] = {};
+        float peakL[lanes] = {}, peakR[lanes] = {};
+
+        int i = 0;
+        for (; i + lanes <= numSamples; i += lanes)
+        {
+            for (int k = 0; k < lanes; ++k)
+            {
+                const double l = left[i + k];
+                const double r = right[i + k];
+
+                ll[k] += l * l;
+                rr[k] += r * r;
+                lr[k] += l * r;
+                peakL[k] = juce::jmax(peakL[k], std::abs(left[i + k]));
+                peakR[k] = juce::jmax(peakR[k], std::abs(right[i + k]));
+            }
+        }
+
+        for (; i < numSamples; ++i)
+        {
+            const double l = left[i];
+            const double r = right[i];
+
+            ll[0] += l * l;
+            rr[0] += r * r;
+            lr[0] += l * r;
+            peakL[0] = juce::jmax(peakL[0], std::abs(left[i]));
+            peakR[0] = juce::jmax(peakR[0], std::abs(right[i]));
+        }
+
+        Sums sums;
+        sums.ll = (ll[0] + ll[1]) + (ll[2] + ll[3]);
+        sums.rr = (rr[0] + rr[1]) + (rr[2] + rr[3]);
+        sums.lr = (lr[0] + lr[1]) + (lr[2] + lr[3]);
+        sums.peakL = juce::jmax(juce::jmax(peakL[0], peakL[1]), juce::jmax(peakL[2], peakL[3]));
+        sums.peakR = juce::jmax(juce::jmax(peakR[0], peakR[1]), juce::jmax(peakR[2], peakR[3]));
+        return sums;
+    }
+
+    Sums measure(const float* left, const float* right, int numSamples,
+                 float* historyLeft, float* historyRight, Sums& outgoing) noexcept
+    {
+        double ll[lanes] = {}, rr[lanes] = {}, lr[lanes] = {};
+        double oldLL[lanes] = {}, oldRR[lanes] = {}, oldLR[lanes] = {};
+        float peakL[lanes] = {}, peakR[lanes] = {};
+
+        int i = 0;
+        for (; i + lanes <= numSamples; i += lanes)
+        {
+            for (int k = 0; k < lanes; ++k)
+            {
+                const float inL = left[i + k];
+                const float inR = right[i + k];
+                const double l = inL;
+                const double r = inR;
+                const double oldL = historyLeft[i + k];
+                const double oldR = historyRight[i + k];
+
+                ll[k] += l * l;
+                rr[k] += r * r;
+                lr[k] += l * r;
+                peakL[k] = juce::jmax(peakL[k], std::abs(inL));
+                peakR[k] = juce::jmax(peakR[k], std::abs(inR));
+
+                oldLL[k] += oldL * oldL;
+                oldRR[k] += oldR * oldR;
+                oldLR[k] += oldL * oldR;
+
+                historyLeft[i + k] = inL;
+                historyRight[i + k] = inR;
+            }
+        }
+
+        for (; i < numSamples; ++i)
+        {
+            const float inL = left[i];
+            const float inR = right[i];
+            const double l = inL;
+            const double r = inR;
+            const double oldL = historyLeft[i];
+            const double oldR = historyRight[i];
+
+            ll[0] += l * l;
+            rr[0] += r * r;
+            lr[0] += l * r;
+            peakL[0] = juce::jmax(peakL[0], std::abs(inL));
+            peakR[0] = juce::jmax(peakR[0], std::abs(inR));
+
+            oldLL[0] += oldL * oldL;
+            oldRR[0] += oldR * oldR;
+            oldLR[0] += oldL * oldR;
+
+            historyLeft[i] = inL;
+            historyRight[i] = inR;
+        }
+
+        outgoing = {};
+        outgoing.ll = (oldLL[0] + oldLL[1]) + (oldLL[2] + oldLL[3]);
+        outgoing.rr = (oldRR[0] + oldRR[1]) + (oldRR[2] + oldRR[3]);
+        outgoing.lr = (oldLR[0] + oldLR[1]) + (oldLR[2] + oldLR[3]);
+
+        Sums sums;
+        sums.ll = (ll[0] + ll[1]) + (ll[2] + ll[3]);
+        sums.rr = (rr[0] + rr[1]) + (rr[2] + rr[3]);
+        sums.lr = (lr[0] + lr[1]) + (lr[2] + lr[3]);
+        sums.peakL = juce::jmax(juce::jmax(peakL[0], peakL[1]), juce::jmax(peakL[2], peakL[3]));
+        sums.peakR = juce::jmax(juce::jmax(peakR[0], peakR[1]), juce::jmax(peakR[2], peakR[3]));
+        return sums;
+    }
+}
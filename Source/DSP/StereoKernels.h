@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    StereoKernels.h
+    Created: 15 Oct 2026 8:47:52pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Shared per-block stereo statistics. The block is measured once, in the same
+// pass that writes it into the correlation window, and the level, correlation
+// and width meters all work from the result instead of each walking the
+// samples again. Like SpectrumKernels the loops use
+// independent partial sums over contiguous memory so they vectorise.
+namespace StereoKernels
+{
+    struct Sums
+    {
+        double ll = 0.0;    // sum of L^2
+        double rr = 0.0;    // sum of R^2
+        double lr = 0.0;    // sum of L*R
+        float peakL = 0.0f; // max |L|
+        float peakR = 0.0f; // max |R|
+
+        // M = (L + R) / 2, S = (L - R) / 2
+        double mm() const noexcept { return 0.25 * (ll + rr + 2.0 * lr); }
+        double ss() const noexcept { return 0.25 * (ll + rr - 2.0 * lr); }
+
+        Sums& operator+=(const Sums& other) noexcept
+        {
+            ll += other.ll;
+            rr += other.rr;
+            lr += other.lr;
+            peakL = juce::jmax(peakL, other.peakL);
+            peakR = juce::jmax(peakR, other.peakR);
+            return *this;
+        }
+
+        // Sums of what is left of a range after other is taken out; the peaks
+        // can't be taken out, so they keep covering the whole range
+        Sums& operator-=(const Sums& other) noexcept
+        {
+            ll -= other.ll;
+            rr -= other.rr;
+            lr -= other.lr;
+            return *this;
+        }
+    };
+
+    // One pass over an L/R pair
+    Sums measure(const float* left, const float* right, int numSamples) noexcept;
+
+    // The same pass, also writing the pair over a history run (the correlation
+    // window). The sums of the samples it replaced come back in outgoing;
+    // their peaks are not tracked.
+    Sums measure(const float* left, const float* right, int numSamples,
+                 float* historyLeft, float* historyRight, Sums& outgoing) noexcept;
+}
@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    StereoScopeTap.cpp
+    Created: 15 Oct 2026 7:48:20pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#include "StereoScopeTap.h"
+
+void StereoScopeTap::prepare(double sampleRate)
+{
+    decimation = juce::jmax(1, juce::roundToInt(sampleRate / pointsPerSecond));
+    skip = 0;
+
+    // a quarter of a second of points
+    ring.prepare(2, juce::nextPowerOfTwo((int)(pointsPerSecond * 0.25)));
+}
+
+void StereoScopeTap::pushAudioBlock(const float* left, const float* right, int numSamples)
+{
+    if (left == nullptr || right == nullptr || !active.load(std::memory_order_relaxed))
+        return;
+
+    const float* chunks[2] = { midChunk, sideChunk };
+    int numPoints = 0;
+    int i = skip;
+
+    for (; i < numSamples; i += decimation)
+    {
+        midChunk[numPoints] = 0.5f * (left[i] + right[i]);
+        sideChunk[numPoints] = 0.5f * (left[i] - right[i]);
+
+        if (++numPoints == chunkSize)
+        {
+            ring.push(chunks, numPoints);
+            numPoints = 0;
+        }
+    }
+
+    if (numPoints > 0)
+        ring.push(chunks, numPoints);
+
+    // the next point is somewhere in a later block
+    skip = i - numSamples;
+}
@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    StereoScopeTap.h
+    Created: 15 Oct 2026 7:48:20pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include "SampleRing.h"
+
+// Audio-side feed for the goniometer. Keeps every n-th sample as a mid/side
+// pair so the point rate is about pointsPerSecond at any sample rate, and
+// hands the points to the GUI through a lock-free ring. If the GUI stops
+// reading (frozen) the ring fills up and new points are dropped.
+class StereoScopeTap
+{
+public:
+    static constexpr double pointsPerSecond = 12000.0;
+
+    enum Channel { mid = 0, side = 1 };
+
+    // Allocates; call while the audio thread is stopped
+    void prepare(double sampleRate);
+
+    // Any thread. While inactive pushAudioBlock() does nothing.
+    void setActive(bool shouldBeActive) noexcept { active.store(shouldBeActive, std::memory_order_relaxed); }
+
+    // Audio thread, never blocks
+    void pushAudioBlock(const float* left, const float* right, int numSamples);
+
+    // GUI thread. Calls fn(const float* const* midSide, int numPoints) for up
+    // to two contiguous runs and returns the number of points read.
+    template <typename Fn>
+    int read(Fn&& fn) { return ring.read(ring.getNumReady(), std::forward<Fn>(fn)); }
+
+private:
+    static constexpr int chunkSize = 256;
+
+    SampleRing ring;
+    std::atomic<bool> active{ true };
+    int decimation = 4;
+    int skip = 0;       // input samples to pass over before the next point
+
+    float midChunk[chunkSize];
+    float sideChunk[chunkSize];
+};
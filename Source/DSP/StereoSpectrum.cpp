@@ -0,0 +1,176 @@
+/*
+  ==============================================================================
+
+    StereoSpectrum.cpp
+    Created: 15 Oct 2026 8:21:06pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#include "StereoSpectrum.h"
+
+static constexpr float stereoSpectrumMinFrequency = 20.0f;
+
+// Columns with less total power than this are left out of the traces
+static constexpr float levelFloorDb = -90.0f;
+
+void StereoSpectrum::setNumColumns(int newNumColumns)
+{
+    newNumColumns = juce::jmax(0, newNumColumns);
+
+    if (newNumColumns == numColumns)
+        return;
+
+    numColumns = newNumColumns;
+
+    for (auto* v : { &columnL, &columnR, &columnCross, &powerL, &powerR, &cross, &width, &correlation, &balance })
+        v->assign((size_t)numColumns, 0.0f);
+
+    audible.assign((size_t)numColumns, 0);
+
+    // rebuild the map and restart the average on the next frame
+    mapSampleRate = 0.0;
+    lastTimestamp = -1;
+}
+
+void StereoSpectrum::update(const SpectrumAnalyzer::Frame& frame, juce::int64 timestamp, double sampleRate)
+{
+    if (numColumns < 2 || frame.numBins <= 0 || frame.crossRe.empty() || timestamp == lastTimestamp)
+        return;
+
+    bool restart = lastTimestamp < 0;
+    lastTimestamp = timestamp;
+
+    if (!displayMap.matches(numColumns, sampleRate, frame.numBins))
+    {
+        displayMap.build(numColumns, sampleRate, frame.numBins, stereoSpectrumMinFrequency);
+        mapSampleRate = sampleRate;
+        restart = true;
+    }
+
+    // Mean power per column. Linear magnitudes come back as sqrt(mean power).
+    const bool magnitudesArePower = frame.scale == SpectrumAnalyzer::MagnitudeScale::power;
+    displayMap.apply(frame.magnitude[0].data(), columnL.data(), SpectrumDisplayMap::Aggregation::energy, magnitudesArePower);
+    displayMap.apply(frame.magnitude[1].data(), columnR.data(), SpectrumDisplayMap::Aggregation::energy, magnitudesArePower);
+    displayMap.apply(frame.crossRe.data(), columnCross.data(), SpectrumDisplayMap::Aggregation::energy, true);
+
+    if (!magnitudesArePower)
+    {
+        juce::FloatVectorOperations::multiply(columnL.data(), columnL.data(), numColumns);
+        juce::FloatVectorOperations::multiply(columnR.data(), columnR.data(), numColumns);
+    }
+
+    const bool analyzerAveraged = frame.averaging != SpectrumAnalyzer::AveragingMode::instantaneous;
+    const float k = (restart || analyzerAveraged) ? 1.0f : frameSmoothing;
+
+    const float floorPower = std::pow(10.0f, levelFloorDb * 0.1f);
+
+    for (int x = 0; x < numColumns; ++x)
+    {
+        powerL[x] += k * (columnL[x] - powerL[x]);
+        powerR[x] += k * (columnR[x] - powerR[x]);
+        cross[x] += k * (columnCross[x] - cross[x]);
+
+        const float ll = powerL[x];
+        const float rr = powerR[x];
+        const float lr = cross[x];
+        const float total = ll + rr;
+
+        if (total <= floorPower)
+        {
+            correlation[x] = 0.0f;
+            width[x] = 0.0f;
+            balance[x] = 0.0f;
+            audible[x] = 0;
+            continue;
+        }
+
+        correlation[x] = (ll > 0.0f && rr > 0.0f) ? juce::jlimit(-1.0f, 1.0f, lr / std::sqrt(ll * rr)) : 0.0f;
+
+        const float mid = 0.25f * (total + 2.0f * lr);
+        const float side = 0.25f * (total - 2.0f * lr);
+        width[x] = mid > 0.0f ? juce::jlimit(0.0f, 2.0f, std::sqrt(juce::jmax(0.0f, side) / mid)) : 2.0f;
+
+        balance[x] = (rr - ll) / total;
+        audible[x] = 1;
+    }
+}
+
+void StereoSpectrum::draw(juce::Graphics& g, juce::Rectangle<int> area) const
+{
+    if (numColumns < 2 || mapSampleRate <= 0.0 || area.getWidth() != numColumns)
+        return;
+
+    auto bounds = area.toFloat();
+    const float traceHeight = bounds.getHeight() / 3.0f;
+
+    drawTrace(g, bounds.removeFromTop(traceHeight).reduced(0.0f, 6.0f), width, 0.0f, 2.0f,
+              juce::Colours::deepskyblue, "WIDTH", "mono", "wide");
+    drawTrace(g, bounds.removeFromTop(traceHeight).reduced(0.0f, 6.0f), correlation, -1.0f, 1.0f,
+              juce::Colours::limegreen, "CORRELATION", "-1", "+1");
+    drawTrace(g, bounds.reduced(0.0f, 6.0f), balance, -1.0f, 1.0f,
+              juce::Colours::orange, "BALANCE", "L", "R");
+
+    // shared frequency grid
+    g.setFont(12.0f);
+    const float logMin = std::log10(stereoSpectrumMinFrequency);
+    const float logMax = std::log10((float)mapSampleRate * 0.5f);
+
+    for (float f : { 100.0f, 1000.0f, 10000.0f })
+    {
+        const float x = area.getX() + (std::log10(f) - logMin) / (logMax - logMin) * area.getWidth();
+
+        g.setColour(juce::Colours::white.withAlpha(0.1f));
+        g.drawVerticalLine((int)x, (float)area.getY(), (float)area.getBottom());
+
+        g.setColour(juce::Colours::white.withAlpha(0.5f));
+        g.drawText(f >= 1000.0f ? juce::String((int)(f / 1000.0f)) + "k" : juce::String((int)f),
+            (int)x + 2, area.getBottom() - 14, 40, 14, juce::Justification::left);
+    }
+}
+
+void StereoSpectrum::drawTrace(juce::Graphics& g, juce::Rectangle<float> area, const std::vector<float>& values,
+                               float minValue, float maxValue, juce::Colour colour, const juce::String& name,
+                               const juce::String& bottomLabel, const juce::String& topLabel) const
+{
+    g.setColour(juce::Colours::white.withAlpha(0.05f));
+    g.fillRect(area);
+
+    g.setColour(juce::Colours::white.withAlpha(0.15f));
+    g.drawHorizontalLine((int)area.getCentreY(), area.getX(), area.getRight());
+
+    // Silent columns break the line rather than pulling it to zero
+    juce::Path path;
+    path.preallocateSpace(numColumns * 3);
+    bool drawing = false;
+
+    for (int x = 0; x < numColumns; ++x)
+    {
+        if (!audible[x])
+        {
+            drawing = false;
+            continue;
+        }
+
+        const float y = juce::jmap(values[x], minValue, maxValue, area.getBottom(), area.getY());
+
+        if (drawing)
+            path.lineTo(area.getX() + x, y);
+        else
+            path.startNewSubPath(area.getX() + x, y);
+
+        drawing = true;
+    }
+
+    g.setColour(colour);
+    g.strokePath(path, juce::PathStrokeType(1.5f));
+
+    g.setFont(12.0f);
+    g.setColour(colour.withAlpha(0.8f));
+    g.drawText(name, area.toNearestInt().reduced(4, 2), juce::Justification::topLeft);
+
+    g.setColour(juce::Colours::white.withAlpha(0.5f));
+    g.drawText(topLabel, area.toNearestInt().reduced(4, 2), juce::Justification::topRight);
+    g.drawText(bottomLabel, area.toNearestInt().reduced(4, 2), juce::Justification::bottomRight);
+}
@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    StereoSpectrum.h
+    Created: 15 Oct 2026 8:21:06pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "SpectrumAnalyzer.h"
+#include "SpectrumDisplayMap.h"
+
+// Width, correlation and balance per display column (GUI thread only).
+//
+// Everything comes from the stereo SpectrumAnalyzer frames: |L|^2, |R|^2 and
+// the cross-spectrum Re(L conj R) are mapped to columns as mean power, and
+//   correlation = Re / sqrt(|L|^2 |R|^2)
+//   width       = sqrt(|S|^2 / |M|^2),  |M|^2, |S|^2 = (|L|^2 + |R|^2 +- 2 Re) / 4
+//   balance     = (|R|^2 - |L|^2) / (|L|^2 + |R|^2)
+// No extra FFTs, just O(bins) per new frame. Frames that the analyzer did not
+// average already are averaged here per column, still in the power domain, since
+// a single frame's correlation is only the cosine of the phase difference.
+class StereoSpectrum
+{
+public:
+    // Reallocates when the width changes
+    void setNumColumns(int newNumColumns);
+
+    // Does nothing unless the frame is new (by timestamp)
+    void update(const SpectrumAnalyzer::Frame& frame, juce::int64 timestamp, double sampleRate);
+
+    // Three stacked traces (width, correlation, balance) on the log frequency axis
+    void draw(juce::Graphics& g, juce::Rectangle<int> area) const;
+
+private:
+    void drawTrace(juce::Graphics& g, juce::Rectangle<float> area, const std::vector<float>& values,
+                   float minValue, float maxValue, juce::Colour colour, const juce::String& name,
+                   const juce::String& bottomLabel, const juce::String& topLabel) const;
+
+    // Weight of each new frame when the analyzer's own averaging is off
+    static constexpr float frameSmoothing = 0.2f;
+
+    SpectrumDisplayMap displayMap;
+    int numColumns = 0;
+    double mapSampleRate = 0.0;
+    juce::int64 lastTimestamp = -1;
+
+    // Column scratch, then the smoothed column powers
+    std::vector<float> columnL, columnR, columnCross;
+    std::vector<float> powerL, powerR, cross;
+
+    std::vector<float> width, correlation, balance;
+    std::vector<char> audible;  // total power above the floor
+};
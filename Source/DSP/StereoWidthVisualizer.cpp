@@ -10,9 +10,16 @@
 
 #include "StereoWidthVisualizer.h"
 
+StereoWidthVisualizer::StereoWidthVisualizer()
+{
+    frames.initialise([](Frame&) {});
+}
+
 void StereoWidthVisualizer::prepare(double sampleRate, int samplesPerBlock)
 {
-    juce::ignoreUnused(sampleRate, samplesPerBlock);
+    juce::ignoreUnused(samplesPerBlock);
+    currentSampleRate = sampleRate;
+    samplesProcessed = 0;
     reset();
 }
 
@@ -23,42 +30,73 @@ void StereoWidthVisualizer::reset()
     sampleCount = 0;
 }
 
-void StereoWidthVisualizer::processBlock(const juce::AudioBuffer<float>& buffer)
+void StereoWidthVisualizer::processBlock(const float* left, const float* right, int numSamples, const StereoKernels::Sums& blockSums)
 {
-    if (buffer.getNumChannels() < 2)
+    if (left == nullptr || right == nullptr)
         return;
 
-    const float* L = buffer.getReadPointer(0);
-    const float* R = buffer.getReadPointer(1);
-    const int N = buffer.getNumSamples();
+    const float* L = left;
+    const float* R = right;
+    const int N = numSamples;
 
-    for (int i = 0; i < N; ++i)
-    {
-        const float l = L[i];
-        const float r = R[i];
+    // Block statistics minus every segment measured so far
+    StereoKernels::Sums remaining = blockSums;
 
-        const float M = 0.5f * (l + r);
-        const float S = 0.5f * (l - r);
+    for (int start = 0; start < N;)
+    {
+        // A window in progress keeps its length; a new one picks up the current setting
+        if (sampleCount == 0)
+            samplesPerWindow = juce::jmax(1, juce::roundToInt(currentSampleRate * 0.001 * requestedWindowMs.load(std::memory_order_relaxed)));
+
+        const int n = juce::jmin(N - start, samplesPerWindow - sampleCount);
+
+        if (start + n == N)
+        {
+            accumulate(remaining, n);
+        }
+        else
+        {
+            const auto segment = StereoKernels::measure(L + start, R + start, n);
+            accumulate(segment, n);
+            remaining -= segment;
+        }
+
+        start += n;
+        samplesProcessed += n;
+
+        if (sampleCount < samplesPerWindow)
+            break;
+
+        if (auto* frame = frames.getFreeFrame())
+        {
+            computeResults(*frame);
+            frames.publish(frame, samplesProcessed);
+        }
+
+        reset();
+    }
+}
 
-        // Correlation data
-        sumL += (double)l * l;
-        sumR += (double)r * r;
-        sumLR += (double)l * r;
+void StereoWidthVisualizer::accumulate(const StereoKernels::Sums& sums, int numSamples) noexcept
+{
+    // Correlation data
+    sumL += sums.ll;
+    sumR += sums.rr;
+    sumLR += sums.lr;
 
-        // M/S width data
-        sumM += (double)M * M;
-        sumS += (double)S * S;
+    // M/S width data
+    sumM += sums.mm();
+    sumS += sums.ss();
 
-        ++sampleCount;
-    }
+    sampleCount += numSamples;
 }
 
-void StereoWidthVisualizer::getResults(float& correlationOut, float& widthOut)
+void StereoWidthVisualizer::computeResults(Frame& frame) const
 {
     if (sampleCount <= 0)
     {
-        correlationOut = 1.0f;
-        widthOut = 0.0f;
+        frame.correlation = 1.0f;
+        frame.width = 0.0f;
         return;
     }
 
@@ -100,8 +138,6 @@ void StereoWidthVisualizer::getResults(float& correlationOut, float& widthOut)
 
     width = juce::jlimit(0.0f, 2.0f, width);
 
-    correlationOut = corr;
-    widthOut = width;
-
-    reset();
+    frame.correlation = corr;
+    frame.width = width;
 }
\ No newline at end of file
@@ -10,22 +10,55 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include <atomic>
+#include "AnalysisFramePool.h"
+#include "StereoKernels.h"
 
+// Correlation and M/S width over fixed-length windows.
+//
+// The audio thread owns the accumulators. Whenever a window's worth of samples
+// has been summed (blocks are split at the exact sample) the totals become a
+// frame and the sums start again, so every sample lands in exactly one window
+// and the window length is set in time, not by how often the GUI looks.
+//
+// The samples themselves are only read when a window ends inside a block; the
+// rest comes from the block's shared statistics.
 class StereoWidthVisualizer
 {
 public:
-    StereoWidthVisualizer() = default;
+    struct Frame
+    {
+        float correlation = 1.0f;
+        float width = 0.0f;
+    };
+
+    using FramePtr = AnalysisFramePool<Frame>::Ptr;
+
+    StereoWidthVisualizer();
 
     void prepare(double sampleRate, int samplesPerBlock);
     void reset();
 
-    // Feed every audio block here
-    void processBlock(const juce::AudioBuffer<float>& buffer);
+    // Any thread. Takes effect from the next window.
+    void setWindowTime(float milliseconds) noexcept { requestedWindowMs.store(milliseconds, std::memory_order_relaxed); }
+
+    // Feed every audio block of the analysed pair here, with its shared
+    // statistics (StereoKernels::measure). Needs both channels.
+    void processBlock(const float* left, const float* right, int numSamples, const StereoKernels::Sums& blockSums);
 
-    // Call from GUI timer (e.g., 3060 Hz)
-    void getResults(float& correlationOut, float& widthOut);
+    // GUI thread: picks up the newest frame (copy the pointer to pin it)
+    const FramePtr& acquireLatestFrame() noexcept { frames.acquire(); return frames.getLatest(); }
 
 private:
+    void accumulate(const StereoKernels::Sums& sums, int numSamples) noexcept;
+    void computeResults(Frame& frame) const;
+
+    AnalysisFramePool<Frame> frames;
+    std::atomic<float> requestedWindowMs{ 100.0f };
+    double currentSampleRate = 44100.0;
+    int samplesPerWindow = 4410;
+    juce::int64 samplesProcessed = 0;
+
     double sumL = 0.0;
     double sumR = 0.0;
     double sumLR = 0.0;
@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    TripleBuffer.h
+    Created: 15 Oct 2026 11:03:47am
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+
+// Wait-free single-producer / single-consumer snapshot exchange.
+//
+// The producer fills the write buffer and publishes it; the consumer acquires
+// the most recently published buffer and can read it for as long as it likes.
+// Neither side ever blocks or allocates, and a slow consumer simply skips frames.
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    // Size / initialise every slot. Only call while neither side is running.
+    template <typename Fn>
+    void forEachBuffer(Fn&& fn)
+    {
+        for (auto& b : buffers)
+            fn(b);
+    }
+
+    // Producer side
+    T& getWriteBuffer() noexcept { return buffers[writeIndex]; }
+
+    void publish() noexcept
+    {
+        writeIndex = middle.exchange(writeIndex | freshBit, std::memory_order_acq_rel) & indexMask;
+    }
+
+    // Consumer side. Returns true if a newer buffer was picked up.
+    bool acquire() noexcept
+    {
+        if ((middle.load(std::memory_order_relaxed) & freshBit) == 0)
+            return false;
+
+        readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    const T& getReadBuffer() const noexcept { return buffers[readIndex]; }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int freshBit = 4;
+
+    T buffers[3];
+    int writeIndex = 0;
+    int readIndex = 1;
+    std::atomic<int> middle{ 2 };
+
+    JUCE_DECLARE_NON_COPYABLE(TripleBuffer)
+};
@@ -0,0 +1,245 @@
+/*
+  ==============================================================================
+
+    TruePeakMeter.cpp
+    Created: 15 Oct 2026 9:26:14pm
+    Author:  Gen3r
+
+  ==============================================================================
+*/
+
+#include "TruePeakMeter.h"
+
+// BS.1770-4 Annex 2 interpolation filter, one row per phase
+static constexpr float interpolationFilter[4][12] =
+{
+    {  0.0017089843750f,  0.0109863281250f, -0.0196533203125f,  0.0332031250000f, -0.0594482421875f,  0.1373291015625f,
+       0.9721679687500f, -0.1022949218750f,  0.0476074218750f, -0.0266113281250f,  0.0148925781250f, -0.0083007812500f },
+    { -0.0291748046875f,  0.0292968750000f, -0.0517578125000f,  0.0891113281250f, -0.1665039062500f,  0.4650878906250f,
+       0.7797851562500f, -0.2003173828125f,  0.1015625000000f, -0.0582275390625f,  0.0330810546875f, -0.0189208984375f },
+    { -0.0189208984375f,  0.0330810546875f, -0.0582275390625f,  0.1015625000000f, -0.2003173828125f,  0.7797851562500f,
+       0.4650878906250f, -0.1665039062500f,  0.0891113281250f, -0.0517578125000f,  0.0292968750000f, -0.0291748046875f },
+    { -0.0083007812500f,  0.0148925781250f, -0.0266113281250f,  0.0476074218750f, -0.1022949218750f,  0.9721679687500f,
+       0.1373291015625f, -0.0594482421875f,  0.0332031250000f, -0.0196533203125f,  0.0109863281250f,  0.0017089843750f }
+};
+
+TruePeakMeter::TruePeakMeter()
+{
+    for (int tap = 0; tap < tapsPerPhase; ++tap)
+        for (int lane = 0; lane < numLanes; ++lane)
+            coefficients[tap].value[lane] = interpolationFilter[lane % numPhases][tap];
+
+    frames.initialise([](Frame& frame)
+        {
+            std::fill(std::begin(frame.blockDb), std::end(frame.blockDb), floorDb);
+            std::fill(std::begin(frame.holdDb), std::end(frame.holdDb), floorDb);
+        });
+
+    prepare(2);
+}
+
+void TruePeakMeter::prepare(int newNumChannels)
+{
+    numChannels = juce::jlimit(1, maxChannels, newNumChannels);
+    numGroups = (numChannels + channelsPerGroup - 1) / channelsPerGroup;
+
+    for (auto& group : state)
+        for (auto& s : group.taps)
+            std::fill(std::begin(s.value), std::end(s.value), 0.0f);
+
+    std::fill(std::begin(holdPeak), std::end(holdPeak), 0.0f);
+    holdResetRequested.store(false, std::memory_order_relaxed);
+    blockPeakDb = floorDb;
+    std::fill(std::begin(samplePeakOver), std::end(samplePeakOver), false);
+    std::fill(std::begin(truePeakOver), std::end(truePeakOver), false);
+    samplesProcessed = 0;
+}
+
+forcedinline void TruePeakMeter::filterSample(GroupState& s, const float* x, float* y) const noexcept
+{
+    // Transposed direct form; every loop below is over the lanes only
+    for (int lane = 0; lane < numLanes; ++lane)
+        y[lane] = coefficients[0].value[lane] * x[lane] + s.taps[0].value[lane];
+
+    for (int tap = 0; tap < tapsPerPhase - 2; ++tap)
+        for (int lane = 0; lane < numLanes; ++lane)
+            s.taps[tap].value[lane] = coefficients[tap + 1].value[lane] * x[lane] + s.taps[tap + 1].value[lane];
+
+    for (int lane = 0; lane < numLanes; ++lane)
+        s.taps[tapsPerPhase - 2].value[lane] = coefficients[tapsPerPhase - 1].value[lane] * x[lane];
+}
+
+void TruePeakMeter::loadGroupInputs(const float* const* channels, int numChannelsPresent, int group,
+                                    const float** inputs) const noexcept
+{
+    // The partner of the last channel in an odd layout, and missing channels, are silent
+    for (int c = 0; c < channelsPerGroup; ++c)
+    {
+        const int ch = group * channelsPerGroup + c;
+        inputs[c] = ch < numChannelsPresent ? channels[ch] : nullptr;
+    }
+}
+
+void TruePeakMeter::pushAudioBlock(const float* const* channels, int numChannelsPresent, int numSamples) noexcept
+{
+    if (channels == nullptr || numSamples <= 0)
+        return;
+
+    numChannelsPresent = juce::jmin(numChannelsPresent, numChannels);
+
+    if (holdResetRequested.exchange(false, std::memory_order_relaxed))
+        std::fill(std::begin(holdPeak), std::end(holdPeak), 0.0f);
+
+    if (eventLog != nullptr)
+        std::copy(std::begin(state), std::begin(state) + numGroups, blockStartState);
+
+    float samplePeak[maxChannels] = {};
+    float interpolatedPeak[maxChannels] = {};
+
+    for (int group = 0; group < numGroups; ++group)
+    {
+        const float* inputs[channelsPerGroup];
+        loadGroupInputs(channels, numChannelsPresent, group, inputs);
+
+        // A local copy, which the compiler knows nothing else can touch
+        GroupState s = state[group];
+
+        alignas(32) float x[numLanes];
+        alignas(32) float y[numLanes];
+        alignas(32) float peak[numLanes] = {};
+        alignas(32) float inputPeak[numLanes] = {};
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            for (int c = 0; c < channelsPerGroup; ++c)
+                std::fill(x + c * numPhases, x + (c + 1) * numPhases, inputs[c] != nullptr ? inputs[c][i] : 0.0f);
+
+            filterSample(s, x, y);
+
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                peak[lane] = juce::jmax(peak[lane], std::abs(y[lane]));
+                inputPeak[lane] = juce::jmax(inputPeak[lane], std::abs(x[lane]));
+            }
+        }
+
+        state[group] = s;
+
+        // The interpolated samples at phase 0 are close to, but not exactly, the input
+        for (int c = 0; c < channelsPerGroup && group * channelsPerGroup + c < numChannels; ++c)
+        {
+            const int ch = group * channelsPerGroup + c;
+            samplePeak[ch] = inputPeak[c * numPhases];
+
+            for (int phase = 0; phase < numPhases; ++phase)
+                interpolatedPeak[ch] = juce::jmax(interpolatedPeak[ch], peak[c * numPhases + phase]);
+        }
+    }
+
+    float loudest = 0.0f;
+    float blockPeak[maxChannels];
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        blockPeak[ch] = juce::jmax(samplePeak[ch], interpolatedPeak[ch]);
+        holdPeak[ch] = juce::jmax(holdPeak[ch], blockPeak[ch]);
+        loudest = juce::jmax(loudest, blockPeak[ch]);
+    }
+
+    blockPeakDb = juce::Decibels::gainToDecibels(loudest, floorDb);
+
+    if (eventLog != nullptr)
+        reportOvers(channels, numChannelsPresent, numSamples, samplePeak, interpolatedPeak);
+
+    samplesProcessed += numSamples;
+
+    auto* frame = frames.getFreeFrame();
+    if (frame == nullptr)
+        return;
+
+    frame->numChannels = numChannels;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        frame->blockDb[ch] = juce::Decibels::gainToDecibels(blockPeak[ch], floorDb);
+        frame->holdDb[ch] = juce::Decibels::gainToDecibels(holdPeak[ch], floorDb);
+    }
+
+    frames.publish(frame, samplesProcessed);
+}
+
+void TruePeakMeter::reportOvers(const float* const* channels, int numChannelsPresent, int numSamples,
+                                const float* samplePeak, const float* interpolatedPeak) noexcept
+{
+    // Missing channels are silent, so they can only end an over
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        if (samplePeak[ch] >= overLevel && !samplePeakOver[ch])
+        {
+            const float* samples = channels[ch];
+
+            int first = 0;
+            while (first < numSamples - 1 && std::abs(samples[first]) < overLevel)
+                ++first;
+
+            eventLog->push(MeterEvent::Type::samplePeakOver, true, ch, juce::Decibels::gainToDecibels(samplePeak[ch]), first);
+        }
+        else if (samplePeak[ch] < overLevel && samplePeakOver[ch])
+        {
+            eventLog->push(MeterEvent::Type::samplePeakOver, false, ch, juce::Decibels::gainToDecibels(samplePeak[ch], floorDb), 0);
+        }
+
+        samplePeakOver[ch] = samplePeak[ch] >= overLevel;
+
+        const float truePeak = interpolatedPeak[ch];
+
+        if (truePeak > overLevel && !truePeakOver[ch])
+        {
+            // may land in the previous block, which is where the over really was
+            eventLog->push(MeterEvent::Type::truePeakOver, true, ch, juce::Decibels::gainToDecibels(truePeak),
+                           findFirstTruePeakOver(channels, numChannelsPresent, numSamples, ch) - filterDelay);
+        }
+        else if (truePeak <= overLevel && truePeakOver[ch])
+        {
+            eventLog->push(MeterEvent::Type::truePeakOver, false, ch, juce::Decibels::gainToDecibels(truePeak, floorDb), 0);
+        }
+
+        truePeakOver[ch] = truePeak > overLevel;
+    }
+}
+
+int TruePeakMeter::findFirstTruePeakOver(const float* const* channels, int numChannelsPresent, int numSamples, int channel) noexcept
+{
+    const int group = channel / channelsPerGroup;
+    const int firstLane = (channel % channelsPerGroup) * numPhases;
+
+    const float* inputs[channelsPerGroup];
+    loadGroupInputs(channels, numChannelsPresent, group, inputs);
+
+    // Walk the block again from where it started; the real state stays as it is
+    GroupState s = blockStartState[group];
+
+    alignas(32) float x[numLanes];
+    alignas(32) float y[numLanes];
+    int first = numSamples - 1;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int c = 0; c < channelsPerGroup; ++c)
+            std::fill(x + c * numPhases, x + (c + 1) * numPhases, inputs[c] != nullptr ? inputs[c][i] : 0.0f);
+
+        filterSample(s, x, y);
+
+        bool over = false;
+        for (int phase = 0; phase < numPhases; ++phase)
+            over = over || std::abs(y[firstLane + phase]) > overLevel;
+
+        if (over)
+        {
+            first = i;
+            break;
+        }
+    }
+
+    return first;
+}
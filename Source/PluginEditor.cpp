@@ -6,7 +6,7 @@
     paint()
      ├── paintViewHeader()
      ├── paintMainView()
-     │    ├── paintSpectrumScreen() OR paintMultibandScreen()
+     │    ├── paintSpectrumScreen() OR paintSpectrogramScreen() OR paintMultibandScreen()
      │    └── drawFrequencyOverlay()
      └── paintMeterFooter()
 
@@ -17,6 +17,10 @@
 #include "PluginEditor.h"
 
 constexpr int viewHeaderHeight = 40;
+
+// Zoom choices for the loudness graph
+constexpr double historySpansSeconds[] = { 60.0, 10.0 * 60.0, 3600.0, 6.0 * 3600.0, 24.0 * 3600.0 };
+constexpr const char* historySpanNames[] = { "1 min", "10 min", "1 hour", "6 hours", "24 hours" };
 constexpr int meterFooterHeight = 40;
 
 //==============================================================================
@@ -29,57 +33,249 @@ YetAnotherAudioAnalyzerAudioProcessorEditor::YetAnotherAudioAnalyzerAudioProcess
 
 
     addAndMakeVisible(spectrumTab);
+    addAndMakeVisible(spectrogramTab);
     addAndMakeVisible(multibandCorrelationTab);
     addAndMakeVisible(stereoTab);
     addAndMakeVisible(lufsTab);
 
     spectrumTab.onClick = [this]() { setView(ViewMode::Spectrum); };
+    spectrogramTab.onClick = [this]() { setView(ViewMode::Spectrogram); };
     multibandCorrelationTab.onClick = [this]() { setView(ViewMode::MultibandCorrelation); };
     stereoTab.onClick = [this]() { setView(ViewMode::StereoWidth); };
     lufsTab.onClick = [this]() { setView(ViewMode::AdvanceLufs); };
 
+    addAndMakeVisible(multiResButton);
+    multiResButton.setClickingTogglesState(true);
+    multiResButton.setToggleState(audioProcessor.isMultiResolutionEnabled(), juce::dontSendNotification);
+    multiResButton.onClick = [this]()
+        {
+            audioProcessor.setMultiResolutionEnabled(multiResButton.getToggleState());
+            analyzerDemand.setDemand(getAnalyzersShownIn(currentView, audioProcessor.isMultiResolutionEnabled()));
+        };
+
+    // Item ids follow the parameter's choice order
+    for (int order = SpectrumAnalyzer::minFFTOrder; order <= SpectrumAnalyzer::maxFFTOrder; ++order)
+        fftSizeBox.addItem(juce::String(1 << order), order - SpectrumAnalyzer::minFFTOrder + 1);
+
+    addAndMakeVisible(fftSizeBox);
+    fftSizeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getParameters(), ParameterIDs::fftSize, fftSizeBox);
+
+    averagingBox.addItem("Instant", 1);
+    averagingBox.addItem("Exponential", 2);
+    averagingBox.addItem("Sliding", 3);
+    addAndMakeVisible(averagingBox);
+    averagingAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getParameters(), ParameterIDs::averagingMode, averagingBox);
+
+    averagingTimeSlider.setTextValueSuffix(" s");
+    addAndMakeVisible(averagingTimeSlider);
+    averagingTimeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+        audioProcessor.getParameters(), ParameterIDs::averagingTime, averagingTimeSlider);
+
+    for (int bands = MultibandCorrelationMeter::minBands; bands <= MultibandCorrelationMeter::maxBands; ++bands)
+        correlationBandsBox.addItem(juce::String(bands) + " bands", bands - MultibandCorrelationMeter::minBands + 1);
+
+    addChildComponent(correlationBandsBox);
+    correlationBandsAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getParameters(), ParameterIDs::correlationBands, correlationBandsBox);
+
+    addChildComponent(resetLoudnessButton);
+    resetLoudnessButton.onClick = [this]()
+        {
+            audioProcessor.getLevelMeter().resetStatistics();
+            audioProcessor.getTruePeakMeter().resetHold();
+        };
+
+    for (int i = 0; i < (int)std::size(historySpanNames); ++i)
+        historySpanBox.addItem(historySpanNames[i], i + 1);
+
+    historySpanBox.setSelectedId(2);
+    addChildComponent(historySpanBox);
+
+    for (int i = 0; i < (int)std::size(loudnessTargetsLufs); ++i)
+        loudnessTargetBox.addItem(juce::String((int)loudnessTargetsLufs[i]) + " LUFS", i + 1);
+
+    addChildComponent(loudnessTargetBox);
+    loudnessTargetAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getParameters(), ParameterIDs::loudnessTarget, loudnessTargetBox);
+
+    recentEvents.reserve((size_t)maxRecentEvents);
+
+    // Item ids follow the parameter's choice order
+    for (int i = 0; i < (int)std::size(analysisPairNames); ++i)
+        analysisPairBox.addItem(analysisPairNames[i], i + 1);
+
+    addAndMakeVisible(analysisPairBox);
+    analysisPairAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getParameters(), ParameterIDs::analysisPair, analysisPairBox);
+
     addAndMakeVisible(monoButton);
     addAndMakeVisible(abButton);
 
     monoButton.onClick = [this]() { /* toggle mono processing */ };
     abButton.onClick = [this]() { /* trigger A/B switch */ };
 
+    addAndMakeVisible(freezeButton);
+    addAndMakeVisible(snapshotButton);
+    addAndMakeVisible(clearSnapshotsButton);
+
+    freezeButton.setClickingTogglesState(true);
+    freezeButton.onClick = [this]() { frozen = freezeButton.getToggleState(); };
+    snapshotButton.onClick = [this]() { takeSnapshot(); };
+    clearSnapshotsButton.onClick = [this]() { snapshots.clear(); repaint(); };
+
+    snapshots.reserve((size_t)maxSnapshots);
+    updateLiveSnapshot();
 
-    // Update GUI 30 times per second
+    // Repaint at 60 Hz so the ballistics move smoothly, but only ask the
+    // analyzers for a new spectrum half as often; the spectrogram doesn't
+    // take more columns than that either
+    audioProcessor.getSpectrumAnalyzer().setMaxFrameRate((float)SpectrogramImage::maxColumnsPerSecond);
+    audioProcessor.getMultiResolutionSpectrum().setMaxFrameRate((float)SpectrogramImage::maxColumnsPerSecond);
     startTimerHz(60);
 }
 
 
+void YetAnotherAudioAnalyzerAudioProcessorEditor::mouseDown(const juce::MouseEvent& event)
+{
+    const bool onLampRow = live.truePeak->numChannels > 2 && truePeakLampArea.contains(event.getPosition());
+
+    if (levelMeterArea.contains(event.getPosition()) || onLampRow)
+        audioProcessor.getTruePeakMeter().resetHold();
+}
+
 void YetAnotherAudioAnalyzerAudioProcessorEditor::setView(ViewMode newView)
 {
     if (currentView == newView)
         return;
 
     currentView = newView;
+    analyzerDemand.setDemand(getAnalyzersShownIn(currentView, audioProcessor.isMultiResolutionEnabled()));
+    correlationBandsBox.setVisible(currentView == ViewMode::MultibandCorrelation);
+
+    // The LUFS view has no spectrum; its own controls take the same space
+    const bool showsSpectrumSettings = currentView != ViewMode::AdvanceLufs;
+    multiResButton.setVisible(showsSpectrumSettings);
+    fftSizeBox.setVisible(showsSpectrumSettings);
+    averagingBox.setVisible(showsSpectrumSettings);
+    averagingTimeSlider.setVisible(showsSpectrumSettings);
+
+    resetLoudnessButton.setVisible(currentView == ViewMode::AdvanceLufs);
+    historySpanBox.setVisible(currentView == ViewMode::AdvanceLufs);
+    loudnessTargetBox.setVisible(currentView == ViewMode::AdvanceLufs);
+    repaint();
+}
+
+juce::uint32 YetAnotherAudioAnalyzerAudioProcessorEditor::getAnalyzersShownIn(ViewMode view, bool multiResolution)
+{
+    switch (view)
+    {
+    case ViewMode::Spectrum:
+        // the multi-resolution line replaces the full-band one rather than adding to it
+        return AnalyzerRegistry::maskOf(multiResolution ? AnalyzerRegistry::multiResolutionSpectrum : AnalyzerRegistry::spectrum);
+    case ViewMode::Spectrogram:
+        return AnalyzerRegistry::maskOf(AnalyzerRegistry::spectrum);
+    case ViewMode::MultibandCorrelation:
+        return AnalyzerRegistry::maskOf(AnalyzerRegistry::multibandCorrelation);
+    case ViewMode::StereoWidth:
+        return AnalyzerRegistry::maskOf(AnalyzerRegistry::stereoScope) | AnalyzerRegistry::maskOf(AnalyzerRegistry::spectrum);
+    case ViewMode::AdvanceLufs:
+        break;
+    }
+
+    // the meters in the footer and the loudness view always run
+    return 0;
+}
+
+void YetAnotherAudioAnalyzerAudioProcessorEditor::updateLiveSnapshot()
+{
+    live.spectrum = audioProcessor.getSpectrumAnalyzer().getLatestFrame();
+    live.correlation = audioProcessor.getCorrelationMeter().acquireLatestFrame();
+    live.multiband = audioProcessor.getMultibandCorrelationMeter().acquireLatestFrame();
+    live.level = audioProcessor.getLevelMeter().acquireLatestFrame();
+    live.truePeak = audioProcessor.getTruePeakMeter().acquireLatestFrame();
+    live.width = audioProcessor.getStereoWidthMeter().acquireLatestFrame();
+}
+
+void YetAnotherAudioAnalyzerAudioProcessorEditor::takeSnapshot()
+{
+    // Oldest goes first; releasing it hands its frames back to the pools
+    if ((int)snapshots.size() >= maxSnapshots)
+        snapshots.erase(snapshots.begin());
+
+    // Only what the overlay shows: the spectrum line plus its loudness and
+    // correlation readings. The other pools keep their slots.
+    AnalysisSnapshot frames;
+    frames.spectrum = live.spectrum;
+    frames.correlation = live.correlation;
+    frames.level = live.level;
+
+    snapshots.push_back({ std::move(frames), {} });
     repaint();
 }
 
 void YetAnotherAudioAnalyzerAudioProcessorEditor::timerCallback()
 {
-    audioProcessor.getSpectrumAnalyzerL().updateSmoothedMagnitudes();
-    audioProcessor.getSpectrumAnalyzerR().updateSmoothedMagnitudes();
+    updateRecentEvents();
+
+    // Frozen: the pinned frames stay as they are and everything downstream stops
+    if (frozen)
+    {
+        repaint();
+        return;
+    }
+
+    // Displays fed by a paused analyzer keep their last picture
+    const auto& registry = audioProcessor.getAnalyzerRegistry();
+    const bool spectrumRunning = registry.isActive(AnalyzerRegistry::spectrum);
+
+    auto& analyzer = audioProcessor.getSpectrumAnalyzer();
+    if (spectrumRunning)
+        analyzer.updateSmoothedMagnitudes();
+
+    updateLiveSnapshot();
+
+    if (spectrumRunning)
+    {
+        // One column per analysis frame, straight from the frame (averaged if
+        // averaging is on) rather than the GUI-smoothed line, so transients
+        // stay in their own column. Stereo-averaged, like the spectrum line.
+        const auto& frame = *live.spectrum;
+        const int numBins = frame.numBins;
+        const int rightChannel = frame.magnitude[1].empty() ? 0 : 1;
+
+        spectrogramInput.resize((size_t)numBins);
+        juce::FloatVectorOperations::add(spectrogramInput.data(), frame.magnitude[0].data(),
+                                         frame.magnitude[rightChannel].data(), numBins);
+        juce::FloatVectorOperations::multiply(spectrogramInput.data(), 0.5f, numBins);
+
+        spectrogram.setFrequencyMap(audioProcessor.getSampleRate(), numBins);
+        spectrogram.addFrame(spectrogramInput.data(), frame.scale == SpectrumAnalyzer::MagnitudeScale::power, frame.timestamp);
+
+        stereoSpectrum.update(frame, frame.timestamp, audioProcessor.getSampleRate());
+    }
+
+    if (registry.isActive(AnalyzerRegistry::stereoScope))
+        goniometer.update(audioProcessor.getStereoScopeTap(), juce::Time::getMillisecondCounterHiRes());
+
+    if (registry.isActive(AnalyzerRegistry::multiResolutionSpectrum))
+        audioProcessor.getMultiResolutionSpectrum().updateSmoothedMagnitudes();
 
-    leftMagnitudes = audioProcessor.getSpectrumAnalyzerL().getMagnitudesCopy();
-    rightMagnitudes = audioProcessor.getSpectrumAnalyzerR().getMagnitudesCopy();
+    if (currentView == ViewMode::AdvanceLufs)
+        updateHistoryPoints();
 
     // LUFS / level
-    float lufs = audioProcessor.getLevelMeter().hasIntegratedLufs() ?
-        audioProcessor.getLevelMeter().getIntegratedLufs() :
-        audioProcessor.getLevelMeter().getLastBlockLufs();
+    float lufs = live.level->integratedValid ? live.level->integratedLufs : live.level->momentaryLufs;
 
     levelValue = lufs;
 
-    correlationValue = audioProcessor.getCorrelationMeter().getCorrelation();
-    audioProcessor.getStereoWidthMeter().getResults(correlationValue, widthValue);
+    correlationValue = live.correlation->correlation;
+    widthValue = live.width->width;
     
     // Load current RMS
-    float rawLeft = audioProcessor.getLevelMeter().lastBlockRmsL.load();
-    float rawRight = audioProcessor.getLevelMeter().lastBlockRmsR.load();
+    float rawLeft = live.level->rmsL;
+    float rawRight = live.level->rmsR;
 
     // Smooth
     smoothedLeft += (rawLeft - smoothedLeft) * smoothingFactor;
@@ -108,6 +304,7 @@ void YetAnotherAudioAnalyzerAudioProcessorEditor::paint(juce::Graphics& g)
         };
 
     highlightTab(spectrumTab, ViewMode::Spectrum);
+    highlightTab(spectrogramTab, ViewMode::Spectrogram);
     highlightTab(multibandCorrelationTab, ViewMode::MultibandCorrelation);
     highlightTab(stereoTab, ViewMode::StereoWidth);
     highlightTab(lufsTab, ViewMode::AdvanceLufs);
@@ -137,9 +334,10 @@ void YetAnotherAudioAnalyzerAudioProcessorEditor::paintMainView(juce::Graphics&
     switch (currentView)
     {
     case ViewMode::Spectrum:        paintSpectrumScreen(g, mainViewArea); break;
+    case ViewMode::Spectrogram:     paintSpectrogramScreen(g, mainViewArea); break;
     case ViewMode::StereoWidth:     paintStereoWidthScreen(g, mainViewArea); break;
     case ViewMode::MultibandCorrelation: paintMultibandScreen(g, mainViewArea); break;
-    case ViewMode::AdvanceLufs:     paintLufsScreen(g, mainViewArea); break;
+    case ViewMode::AdvanceLufs:     paintLufsScreen(g); break;
     }
 }
 
@@ -200,6 +398,46 @@ void YetAnotherAudioAnalyzerAudioProcessorEditor::paintMeterFooter(juce::Graphic
     g.fillRect(lmX, peakLeftY, lmW / 2, 2);
     g.fillRect(lmX + lmW / 2, peakRightY, lmW / 2, 2);
 
+    // True-peak overs since the last reset (click the meter to reset)
+    const float overDb = 0.0f;
+    const int overHeight = 4;
+
+    // One lamp per bus channel, in bus order. Up to stereo they sit on top of
+    // the meter; a surround bus gets a labelled row next to the buttons.
+    const int numLamps = juce::jmax(1, live.truePeak->numChannels);
+
+    if (numLamps <= 2)
+    {
+        for (int ch = 0; ch < numLamps; ++ch)
+        {
+            const bool over = live.truePeak->holdDb[ch] > overDb;
+            const int lampX = lmX + ch * lmW / numLamps;
+
+            g.setColour(over ? juce::Colours::red : juce::Colours::darkgrey);
+            g.fillRect(lampX, lmY, lmX + (ch + 1) * lmW / numLamps - lampX, overHeight);
+        }
+    }
+    else
+    {
+        const auto busLayout = audioProcessor.getChannelLayoutOfBus(true, 0);
+        const int lampWidth = juce::jmin(40, truePeakLampArea.getWidth() / numLamps);
+        auto lamps = truePeakLampArea;
+
+        g.setFont(11.0f);
+
+        for (int ch = 0; ch < numLamps; ++ch)
+        {
+            const bool over = live.truePeak->holdDb[ch] > overDb;
+            const auto lamp = lamps.removeFromLeft(lampWidth).reduced(2, 0);
+
+            g.setColour(over ? juce::Colours::red : juce::Colours::darkgrey);
+            g.fillRect(lamp);
+
+            g.setColour(over ? juce::Colours::white : juce::Colours::white.withAlpha(0.6f));
+            g.drawText(getChannelName(busLayout, ch), lamp, juce::Justification::centred);
+        }
+    }
+
     // =============================
     // STEREO SECTION
     // =============================
@@ -222,80 +460,118 @@ void YetAnotherAudioAnalyzerAudioProcessorEditor::paintMeterFooter(juce::Graphic
 
 void YetAnotherAudioAnalyzerAudioProcessorEditor::paintSpectrumScreen(juce::Graphics& g, juce::Rectangle<int> area)
 {
-    const auto& magsL = leftMagnitudes;
-    const auto& magsR = rightMagnitudes;
+    auto& analyzer = audioProcessor.getSpectrumAnalyzer();
+    const auto& magsL = analyzer.getSmoothedMagnitudes(0);
+    const auto& magsR = analyzer.getSmoothedMagnitudes(1);
     if (magsL.empty() || magsR.empty())
         return;
 
+    // Only rebuilds after a resize or a sample rate / FFT size change
+    updateSpectrumDisplayMap();
+
+    const int numColumns = spectrumDisplayMap.getNumColumns();
+    if (numColumns < 2 || numColumns != area.getWidth())
+        return;
+
     juce::Path spectrumPath;
-    spectrumPath.preallocateSpace(area.getWidth() * 3);
+    spectrumPath.preallocateSpace(numColumns * 3);
 
     const float minDb = -60.0f;
     const float maxDb = 0.0f;
-    const float refAmplitude = 1.0f;
-    const int numBins = (int)magsL.size();
-    const float nyquist = audioProcessor.getSampleRate() * 0.5f;
 
-    // SPAN-style smoothing per pixel
-    static std::vector<float> smoothed(area.getWidth(), 0.0f);
-    const float attack = 0.6f;     // fast attack
+    // SPAN-style smoothing per column, given for linear magnitudes; the columns
+    // below are power, so every coefficient goes through toPowerCoefficient()
+    const float attack = SpectrumAnalyzer::toPowerCoefficient(0.6f);     // fast attack
     const float releaseLow = 0.02f; // low freq decay
     const float releaseHigh = 0.25f; // high freq decay
 
-    const float logMin = std::log10(20.0f);
-    const float logMax = std::log10(nyquist);
+    // Multi-resolution points already sit on the same 20 Hz..Nyquist log axis.
+    // The full-band analyzer is paused while they are shown.
+    const bool useMultiRes = audioProcessor.isMultiResolutionEnabled();
+    const auto& multiResL = audioProcessor.getMultiResolutionSpectrum().getPointPowers(0);
+    const auto& multiResR = audioProcessor.getMultiResolutionSpectrum().getPointPowers(1);
+    const int numPoints = audioProcessor.getMultiResolutionSpectrum().getNumPoints();
+
+    if (!useMultiRes)
+    {
+        // Peak-preserving bins -> columns (max works the same on power and magnitude)
+        spectrumDisplayMap.apply(magsL.data(), spectrumColumnsL.data(), SpectrumDisplayMap::Aggregation::max);
+        spectrumDisplayMap.apply(magsR.data(), spectrumColumnsR.data(), SpectrumDisplayMap::Aggregation::max);
+
+        // From here on every column is power; a linear analyzer only costs a square per column
+        if (analyzer.getSmoothedScale() == SpectrumAnalyzer::MagnitudeScale::linear)
+        {
+            juce::FloatVectorOperations::multiply(spectrumColumnsL.data(), spectrumColumnsL.data(), numColumns);
+            juce::FloatVectorOperations::multiply(spectrumColumnsR.data(), spectrumColumnsR.data(), numColumns);
+        }
+    }
 
     // Compute peak for adaptive scaling
     float globalPeak = 0.0f;
 
-    for (int x = 0; x < area.getWidth(); ++x)
+    for (int x = 0; x < numColumns; ++x)
     {
-        float xNorm = (float)x / (float)(area.getWidth() - 1);
-        float logFreq = logMin + xNorm * (logMax - logMin);
-        float freq = std::pow(10.0f, logFreq);
+        const float freq = spectrumDisplayMap.getColumnFrequency(x);
 
-        // fractional bin index
-        float binFloat = freq / nyquist * (numBins - 1);
-        int bin0 = (int)std::floor(binFloat);
-        int bin1 = juce::jmin(bin0 + 1, numBins - 1);
-        float frac = binFloat - bin0;
+        // Stereo-averaged power
+        float power;
 
-        // Stereo-averaged magnitude
-        float mag = 0.5f * (magsL[bin0] + magsR[bin0]) * (1.0f - frac)
-            + 0.5f * (magsL[bin1] + magsR[bin1]) * frac;
+        if (useMultiRes)
+        {
+            float pointFloat = (float)x / (float)(numColumns - 1) * (numPoints - 1);
+            int p0 = juce::jlimit(0, numPoints - 1, (int)pointFloat);
+            int p1 = juce::jmin(p0 + 1, numPoints - 1);
+            float pFrac = pointFloat - p0;
+
+            power = 0.5f * (multiResL[p0] + multiResR[p0]) * (1.0f - pFrac)
+                  + 0.5f * (multiResL[p1] + multiResR[p1]) * pFrac;
+        }
+        else
+        {
+            power = 0.5f * (spectrumColumnsL[x] + spectrumColumnsR[x]);
+        }
 
-        // Optional low-frequency slope (20–200 Hz)
+        // Optional low-frequency slope (20–200 Hz), squared for power
         if (freq < 200.0f)
-            mag *= 0.6f + 0.4f * (freq / 200.0f);
+        {
+            const float slope = 0.6f + 0.4f * (freq / 200.0f);
+            power *= slope * slope;
+        }
 
-        globalPeak = juce::jmax(globalPeak, mag);
+        globalPeak = juce::jmax(globalPeak, power);
 
         // Store temporarily for smoothing
-        smoothed[x] = mag;
+        spectrumColumnsL[x] = power;
     }
 
     // Optional: adaptive scaling for bass-heavy peaks
     float scale = juce::jmax(1.0f, globalPeak);
-    for (int x = 0; x < area.getWidth(); ++x)
-        smoothed[x] /= scale;
 
-    // Apply dynamic smoothing per pixel and map to dB
-    for (int x = 0; x < area.getWidth(); ++x)
+    // Averaged frames are already smoothed in audio time, don't add frame-rate ballistics on top
+    const bool averaged = live.spectrum->averaging != SpectrumAnalyzer::AveragingMode::instantaneous;
+
+    // Apply dynamic smoothing per column and map to dB
+    for (int x = 0; x < numColumns; ++x)
     {
-        float freqRatio = (float)x / (float)area.getWidth();
-        float release = juce::jmap(freqRatio, 0.0f, 1.0f, releaseLow, releaseHigh);
+        float freqRatio = (float)x / (float)numColumns;
+        float release = SpectrumAnalyzer::toPowerCoefficient(juce::jmap(freqRatio, 0.0f, 1.0f, releaseLow, releaseHigh));
 
-        // Dynamic smoothing
-        if (smoothed[x] > smoothed[x])
-            smoothed[x] = attack * smoothed[x] + (1.0f - attack) * smoothed[x];
+        // Dynamic smoothing against the previous frame's column value
+        const float target = spectrumColumnsL[x] / scale;
+        float& state = spectrumColumnState[x];
+
+        if (averaged)
+            state = target;
+        else if (target > state)
+            state = attack * target + (1.0f - attack) * state;
         else
-            smoothed[x] = release * smoothed[x] + (1.0f - release) * smoothed[x];
+            state = release * target + (1.0f - release) * state;
 
-        // Clamp linear magnitude
-        float mag = juce::jmin(smoothed[x], 1.0f);
+        // Clamp to full scale
+        float power = juce::jmin(state, 1.0f);
 
         // Convert to dB
-        float db = juce::Decibels::gainToDecibels(mag / refAmplitude);
+        float db = power > 0.0f ? 10.0f * std::log10(power) : minDb;
         db = juce::jlimit(minDb, maxDb, db);
 
         // Map to vertical pixel
@@ -308,20 +584,189 @@ void YetAnotherAudioAnalyzerAudioProcessorEditor::paintSpectrumScreen(juce::Grap
             spectrumPath.lineTo(area.getX() + x, y);
     }
 
+    drawSpectrumSnapshots(g, area);
+
     // Draw spectrum
-    g.setColour(juce::Colours::lightblue);
+    g.setColour(frozen ? juce::Colours::lightblue.brighter(0.4f) : juce::Colours::lightblue);
     g.strokePath(spectrumPath, juce::PathStrokeType(1.5f));
 
     // Draw frequency overlay & grid
     drawFrequencyOverlay(g, area);
 }
 
+void YetAnotherAudioAnalyzerAudioProcessorEditor::drawSpectrumSnapshots(juce::Graphics& g, juce::Rectangle<int> area)
+{
+    const juce::Colour colours[] = { juce::Colours::orange, juce::Colours::violet, juce::Colours::lightgreen };
+    const double sampleRate = audioProcessor.getSampleRate();
+    const int numColumns = area.getWidth();
+
+    snapshotColumnsL.resize((size_t)numColumns);
+    snapshotColumnsR.resize((size_t)numColumns);
+
+    g.setFont(12.0f);
+
+    for (size_t i = 0; i < snapshots.size(); ++i)
+    {
+        auto& snapshot = snapshots[i];
+        const auto& frame = *snapshot.frames.spectrum;
+
+        if (frame.numBins <= 0)
+            continue;
+
+        if (!snapshot.displayMap.matches(numColumns, sampleRate, frame.numBins))
+            snapshot.displayMap.build(numColumns, sampleRate, frame.numBins);
+
+        // A mono frame only fills the first channel
+        const int rightChannel = frame.magnitude[1].empty() ? 0 : 1;
+        snapshot.displayMap.apply(frame.magnitude[0].data(), snapshotColumnsL.data(), SpectrumDisplayMap::Aggregation::max);
+        snapshot.displayMap.apply(frame.magnitude[rightChannel].data(), snapshotColumnsR.data(), SpectrumDisplayMap::Aggregation::max);
+
+        // Same as the live line: columns become power, then 10 * log10
+        if (frame.scale == SpectrumAnalyzer::MagnitudeScale::linear)
+        {
+            juce::FloatVectorOperations::multiply(snapshotColumnsL.data(), snapshotColumnsL.data(), numColumns);
+            juce::FloatVectorOperations::multiply(snapshotColumnsR.data(), snapshotColumnsR.data(), numColumns);
+        }
+
+        juce::Path path;
+        path.preallocateSpace(numColumns * 3);
+
+        for (int x = 0; x < numColumns; ++x)
+        {
+            float power = 0.5f * (snapshotColumnsL[(size_t)x] + snapshotColumnsR[(size_t)x]);
+
+            // same low-frequency slope as the live line
+            const float freq = snapshot.displayMap.getColumnFrequency(x);
+            if (freq < 200.0f)
+            {
+                const float slope = 0.6f + 0.4f * (freq / 200.0f);
+                power *= slope * slope;
+            }
+
+            const float db = juce::jlimit(minDb, maxDb, power > 0.0f ? 10.0f * std::log10(power) : minDb);
+            const float y = juce::jmap(db, minDb, maxDb, (float)area.getBottom(), (float)area.getY());
+
+            if (x == 0)
+                path.startNewSubPath((float)area.getX(), y);
+            else
+                path.lineTo((float)(area.getX() + x), y);
+        }
+
+        const auto colour = colours[i % (sizeof(colours) / sizeof(colours[0]))];
+        g.setColour(colour.withAlpha(0.5f));
+        g.strokePath(path, juce::PathStrokeType(1.0f));
+
+        // Label with the sample position the frame was taken at and the
+        // loudness and correlation at that moment, to compare with the footer
+        const double seconds = sampleRate > 0.0 ? (double)snapshot.frames.spectrum->timestamp / sampleRate : 0.0;
+        const auto& level = *snapshot.frames.level;
+        auto lufs = [](float value) { return std::isnan(value) ? juce::String("--") : juce::String(value, 1); };
+
+        g.setColour(colour.withAlpha(0.8f));
+        g.drawText("S" + juce::String((int)i + 1) + "  " + juce::String(seconds, 1) + " s"
+                       + "   ST " + lufs(level.shortTermLufs)
+                       + "  I " + lufs(level.integratedValid ? level.integratedLufs : std::numeric_limits<float>::quiet_NaN()) + " LUFS"
+                       + "   corr " + juce::String(snapshot.frames.correlation->correlation, 2),
+            area.getRight() - 324, area.getY() + 4 + (int)i * 14, 320, 14, juce::Justification::right);
+    }
+}
+
+void YetAnotherAudioAnalyzerAudioProcessorEditor::updateSpectrumDisplayMap()
+{
+    const int numColumns = mainViewArea.getWidth();
+    const double sampleRate = audioProcessor.getSampleRate();
+    const int numBins = audioProcessor.getSpectrumAnalyzer().getNumBins();
+
+    if (spectrumDisplayMap.matches(numColumns, sampleRate, numBins))
+        return;
+
+    spectrumDisplayMap.build(numColumns, sampleRate, numBins);
+
+    spectrumColumnsL.assign((size_t)numColumns, 0.0f);
+    spectrumColumnsR.assign((size_t)numColumns, 0.0f);
+    spectrumColumnState.assign((size_t)numColumns, 0.0f);
+}
+
+void YetAnotherAudioAnalyzerAudioProcessorEditor::paintSpectrogramScreen(juce::Graphics& g, juce::Rectangle<int> area)
+{
+    g.setColour(juce::Colours::black);
+    g.fillRect(area);
+
+    spectrogram.draw(g, area);
+
+    // Frequency labels on the left, time runs right to left from "now"
+    g.setFont(12.0f);
+
+    for (float f : { 50.0f, 100.0f, 200.0f, 500.0f, 1000.0f, 2000.0f, 5000.0f, 10000.0f })
+    {
+        const float y = area.getBottom() - spectrogram.getFrequencyPosition(f) * area.getHeight();
+
+        g.setColour(juce::Colours::white.withAlpha(0.15f));
+        g.drawHorizontalLine((int)y, (float)area.getX(), (float)area.getRight());
+
+        g.setColour(juce::Colours::white.withAlpha(0.6f));
+        g.drawText(f >= 1000.0f ? juce::String((int)(f / 1000.0f)) + "k" : juce::String((int)f),
+            area.getX() + 4, (int)y - 14, 40, 14, juce::Justification::left);
+    }
+
+    g.drawText("-" + juce::String(juce::roundToInt(spectrogram.getHistorySeconds())) + " s",
+        area.getX() + 4, area.getBottom() - 16, 60, 14, juce::Justification::left);
+}
+
 void YetAnotherAudioAnalyzerAudioProcessorEditor::paintMultibandScreen(juce::Graphics& g, juce::Rectangle<int> area)
 {
-    g.setColour(juce::Colours::white);
-    g.drawText("Multiband correlation screen (WIP)",
-        area.reduced(20),
-        juce::Justification::centredLeft);
+    g.setColour(juce::Colours::black);
+    g.fillRect(area);
+
+    const auto& frame = *live.multiband;
+    const int numBands = frame.numBands;
+    if (numBands <= 0)
+        return;
+
+    auto bounds = area.reduced(20);
+    auto labels = bounds.removeFromBottom(20);
+    auto values = bounds.removeFromTop(20);
+
+    // +1 at the top, -1 at the bottom
+    const float zeroY = (float)bounds.getCentreY();
+    const float halfHeight = bounds.getHeight() * 0.5f;
+
+    g.setColour(juce::Colours::white.withAlpha(0.15f));
+    for (float c : { -1.0f, -0.5f, 0.0f, 0.5f, 1.0f })
+        g.drawHorizontalLine((int)(zeroY - c * halfHeight), (float)bounds.getX(), (float)bounds.getRight());
+
+    auto formatHz = [](float f)
+        {
+            return f >= 1000.0f ? juce::String(f / 1000.0f, 1) + "k" : juce::String((int)f);
+        };
+
+    g.setFont(12.0f);
+    const float bandWidth = (float)bounds.getWidth() / (float)numBands;
+
+    for (int b = 0; b < numBands; ++b)
+    {
+        const float x = bounds.getX() + b * bandWidth;
+        const auto column = juce::Rectangle<float>(x, (float)bounds.getY(), bandWidth, (float)bounds.getHeight()).reduced(6.0f, 0.0f);
+
+        const float correlation = frame.correlation[b];
+        const float barTop = correlation >= 0.0f ? zeroY - correlation * halfHeight : zeroY;
+
+        g.setColour(correlation >= 0.0f ? juce::Colours::limegreen.withAlpha(0.8f) : juce::Colours::red.withAlpha(0.8f));
+        g.fillRect(column.withY(barTop).withHeight(std::abs(correlation) * halfHeight));
+
+        // width as a marker on the same scale: 0 (mono) at the top, 2 at the bottom
+        const float widthY = bounds.getY() + juce::jlimit(0.0f, 1.0f, frame.width[b] * 0.5f) * bounds.getHeight();
+        g.setColour(juce::Colours::deepskyblue);
+        g.fillRect(column.getX(), widthY - 1.0f, column.getWidth(), 2.0f);
+
+        g.setColour(juce::Colours::white.withAlpha(0.8f));
+        g.drawText(juce::String(correlation, 2) + "  W " + juce::String(frame.width[b], 2),
+            (int)x, values.getY(), (int)bandWidth, values.getHeight(), juce::Justification::centred);
+
+        g.setColour(juce::Colours::white.withAlpha(0.6f));
+        g.drawText(formatHz(frame.edgeHz[b]) + " - " + formatHz(frame.edgeHz[b + 1]) + " Hz",
+            (int)x, labels.getY(), (int)bandWidth, labels.getHeight(), juce::Justification::centred);
+    }
 }
 
 void YetAnotherAudioAnalyzerAudioProcessorEditor::paintStereoWidthScreen(juce::Graphics& g, juce::Rectangle<int> area)
@@ -329,10 +774,12 @@ void YetAnotherAudioAnalyzerAudioProcessorEditor::paintStereoWidthScreen(juce::G
     g.setColour(juce::Colours::black);
     g.fillRect(area);
 
-    auto bounds = area.reduced(20);
-    auto center = bounds.getCentre().toFloat();
+    auto center = goniometerArea.getCentre().toFloat();
+
+    float size = (float)juce::jmin(goniometerArea.getWidth(), goniometerArea.getHeight()) * 0.5f;
 
-    float size = (float)juce::jmin(bounds.getWidth(), bounds.getHeight()) * 0.5f;
+    // Phase cloud underneath the grid
+    goniometer.draw(g, juce::Rectangle<float>(center.x - size, center.y - size, size * 2.0f, size * 2.0f));
 
     // =============================
     // Draw Diamond Grid
@@ -357,27 +804,261 @@ void YetAnotherAudioAnalyzerAudioProcessorEditor::paintStereoWidthScreen(juce::G
         center.x,
         center.y + size);
 
-    // =============================
-    // Draw Stereo Points
-    // =============================
+    stereoSpectrum.draw(g, stereoSpectrumArea);
+}
+
+void YetAnotherAudioAnalyzerAudioProcessorEditor::paintLufsScreen(juce::Graphics& g)
+{
+    const auto& level = *live.level;
+    const auto& truePeak = *live.truePeak;
+    const auto busLayout = audioProcessor.getChannelLayoutOfBus(true, 0);
+
+    int loudestChannel = 0;
+    for (int ch = 1; ch < truePeak.numChannels; ++ch)
+        if (truePeak.holdDb[ch] > truePeak.holdDb[loudestChannel])
+            loudestChannel = ch;
+
+    // NaN until there is enough programme to measure
+    auto format = [](float value, const char* unit)
+        {
+            return std::isnan(value) ? juce::String("--") : juce::String(value, 1) + unit;
+        };
 
-    g.setColour(juce::Colours::deepskyblue.withAlpha(0.4f));
+    const std::pair<const char*, juce::String> loudness[] =
+    {
+        { "Momentary",  format(level.momentaryLufs, " LUFS") },
+        { "Short-term", format(level.shortTermLufs, " LUFS") },
+        { "Integrated", format(level.integratedValid ? level.integratedLufs : std::numeric_limits<float>::quiet_NaN(), " LUFS") },
+        { "Range (LRA)", format(level.loudnessRange, " LU") }
+    };
 
-    for (auto& p : stereoScopePoints)
+    const std::pair<const char*, juce::String> statistics[] =
+    {
+        { "LRA low (10%)",  format(level.rangeLowLufs, " LUFS") },
+        { "LRA high (95%)", format(level.rangeHighLufs, " LUFS") },
+        { "Short-term min", format(level.shortTermMinLufs, " LUFS") },
+        { "Short-term max", format(level.shortTermMaxLufs, " LUFS") },
+        { "True peak max", format(truePeak.holdDb[loudestChannel], " dBTP  ") + getChannelName(busLayout, loudestChannel) }
+    };
+
+    auto content = lufsReadoutArea;
+    auto left = content.removeFromLeft(content.getWidth() / 3);
+    auto right = content.removeFromLeft(content.getWidth() / 2);
+    auto eventsArea = content;
+
+    const int bigRowHeight = 44;
+    const int rowHeight = 26;
+    const int labelWidth = 140;
+
+    for (const auto& [label, value] : loudness)
     {
-        float x = center.x + p.x * size * 2.0f;
-        float y = center.y - p.y * size * 2.0f;
+        auto row = left.removeFromTop(bigRowHeight);
+
+        g.setColour(juce::Colours::white.withAlpha(0.6f));
+        g.setFont(14.0f);
+        g.drawText(label, row.removeFromLeft(labelWidth), juce::Justification::centredLeft);
+
+        g.setColour(juce::Colours::white);
+        g.setFont(28.0f);
+        g.drawText(value, row, juce::Justification::centredLeft);
+    }
+
+    g.setFont(14.0f);
+
+    for (const auto& [label, value] : statistics)
+    {
+        auto row = right.removeFromTop(rowHeight);
+
+        g.setColour(juce::Colours::white.withAlpha(0.6f));
+        g.drawText(label, row.removeFromLeft(labelWidth), juce::Justification::centredLeft);
+
+        g.setColour(juce::Colours::white);
+        g.drawText(value, row, juce::Justification::centredLeft);
+    }
+
+    // Newest event on top
+    g.setColour(juce::Colours::white.withAlpha(0.6f));
+    g.drawText("Events", eventsArea.removeFromTop(rowHeight), juce::Justification::centredLeft);
+
+    for (auto it = recentEvents.rbegin(); it != recentEvents.rend(); ++it)
+    {
+        g.setColour(it->isStart ? juce::Colours::salmon : juce::Colours::white.withAlpha(0.6f));
+        g.drawText(describeEvent(*it, audioProcessor.getSampleRate(), busLayout), eventsArea.removeFromTop(rowHeight - 4),
+                   juce::Justification::centredLeft);
+    }
 
-        g.fillEllipse(x, y, 2.0f, 2.0f);
+    drawLoudnessHistory(g);
+}
+
+void YetAnotherAudioAnalyzerAudioProcessorEditor::updateRecentEvents()
+{
+    recentEvents.resize((size_t)maxRecentEvents);
+    recentEvents.resize((size_t)audioProcessor.getMeterEventLog().getRecentEvents(recentEvents.data(), maxRecentEvents));
+}
+
+juce::String YetAnotherAudioAnalyzerAudioProcessorEditor::getChannelName(const juce::AudioChannelSet& layout, int channel)
+{
+    return juce::isPositiveAndBelow(channel, layout.size())
+               ? juce::AudioChannelSet::getAbbreviatedChannelTypeName(layout.getTypeOfChannel(channel))
+               : juce::String(channel + 1);
+}
+
+juce::String YetAnotherAudioAnalyzerAudioProcessorEditor::describeEvent(const MeterEvent& event, double sampleRate,
+                                                                        const juce::AudioChannelSet& layout)
+{
+    // host timeline when there is one, time since playback started otherwise
+    const double seconds = event.hostTimeInSeconds >= 0.0 ? event.hostTimeInSeconds
+                                                          : (double)event.samplePosition / juce::jmax(1.0, sampleRate);
+
+    const int totalMs = (int)(seconds * 1000.0);
+    const juce::String time = juce::String(totalMs / 3600000) + ":"
+                            + juce::String((totalMs / 60000) % 60).paddedLeft('0', 2) + ":"
+                            + juce::String((totalMs / 1000) % 60).paddedLeft('0', 2) + "."
+                            + juce::String(totalMs % 1000).paddedLeft('0', 3);
+
+    const juce::String channel = event.channel >= 0 ? " " + getChannelName(layout, event.channel) : juce::String();
+
+    switch (event.type)
+    {
+        case MeterEvent::Type::samplePeakOver:
+            return time + (event.isStart ? "  clip" : "  clip cleared") + channel
+                   + (event.isStart ? "  " + juce::String(event.value, 1) + " dBFS" : juce::String());
+        case MeterEvent::Type::truePeakOver:
+            return time + (event.isStart ? "  true-peak over" : "  true-peak over cleared") + channel
+                   + (event.isStart ? "  " + juce::String(event.value, 1) + " dBTP" : juce::String());
+        case MeterEvent::Type::shortTermAboveTarget:
+            return time + (event.isStart ? "  above target  " : "  back on target  ") + juce::String(event.value, 1) + " LUFS";
+        case MeterEvent::Type::correlationNegative:
+            return time + (event.isStart ? "  negative correlation  " : "  correlation positive  ") + juce::String(event.value, 2);
     }
+
+    return time;
+}
+
+void YetAnotherAudioAnalyzerAudioProcessorEditor::updateHistoryPoints()
+{
+    const int numPoints = (int)historyPoints[0].size();
+    const double span = historySpansSeconds[juce::jlimit(0, (int)std::size(historySpansSeconds) - 1, historySpanBox.getSelectedId() - 1)];
+
+    for (int s = 0; s < MeterHistory::numSeries; ++s)
+        audioProcessor.getMeterHistory().read((MeterHistory::Series)s, span, historyPoints[s].data(), numPoints);
 }
 
-void YetAnotherAudioAnalyzerAudioProcessorEditor::paintLufsScreen(juce::Graphics& g, juce::Rectangle<int> area)
+void YetAnotherAudioAnalyzerAudioProcessorEditor::drawLoudnessHistory(juce::Graphics& g)
 {
+    const float minLufs = -60.0f;
+    const float maxLufs = 0.0f;
+
+    auto lufsToY = [this, minLufs, maxLufs](float lufs)
+        {
+            return juce::jmap(juce::jlimit(minLufs, maxLufs, lufs), minLufs, maxLufs,
+                              (float)loudnessHistoryArea.getBottom(), (float)loudnessHistoryArea.getY());
+        };
+
+    auto correlationToY = [this](float correlation)
+        {
+            return juce::jmap(juce::jlimit(-1.0f, 1.0f, correlation), -1.0f, 1.0f,
+                              (float)correlationHistoryArea.getBottom(), (float)correlationHistoryArea.getY());
+        };
+
+    g.setColour(juce::Colours::black.withAlpha(0.4f));
+    g.fillRect(loudnessHistoryArea);
+    g.fillRect(correlationHistoryArea);
+
+    // LUFS grid
+    g.setFont(11.0f);
+    for (float lufs = minLufs; lufs <= maxLufs; lufs += 10.0f)
+    {
+        const float y = lufsToY(lufs);
+        g.setColour(juce::Colours::white.withAlpha(0.15f));
+        g.drawHorizontalLine((int)y, (float)loudnessHistoryArea.getX(), (float)loudnessHistoryArea.getRight());
+        g.setColour(juce::Colours::white.withAlpha(0.5f));
+        g.drawText(juce::String((int)lufs), loudnessHistoryArea.getX() + 2, (int)y - 12, 30, 12, juce::Justification::left);
+    }
+
+    g.setColour(juce::Colours::white.withAlpha(0.15f));
+    g.drawHorizontalLine((int)correlationToY(0.0f), (float)correlationHistoryArea.getX(), (float)correlationHistoryArea.getRight());
+
+    const auto& momentaryPoints = historyPoints[MeterHistory::momentary];
+    const auto& shortTermPoints = historyPoints[MeterHistory::shortTerm];
+    const auto& truePeakPoints = historyPoints[MeterHistory::truePeak];
+    const auto& correlationPoints = historyPoints[MeterHistory::correlation];
+
+    juce::Path shortTermPath, truePeakPath, correlationPath;
+    bool shortTermStarted = false, truePeakStarted = false, correlationStarted = false;
+
+    // a gap (NaN) lifts the pen
+    auto extend = [](juce::Path& path, bool& started, float x, float y, float value)
+        {
+            if (std::isnan(value))
+            {
+                started = false;
+                return;
+            }
+
+            if (started)
+                path.lineTo(x, y);
+            else
+                path.startNewSubPath(x, y);
+
+            started = true;
+        };
+
+    for (size_t i = 0; i < momentaryPoints.size(); ++i)
+    {
+        const float x = (float)loudnessHistoryArea.getX() + (float)i + 0.5f;
+
+        // momentary spread per column
+        const auto& m = momentaryPoints[i];
+        if (!std::isnan(m.mean))
+        {
+            g.setColour(juce::Colours::deepskyblue.withAlpha(0.35f));
+            g.drawVerticalLine((int)x, lufsToY(m.max), lufsToY(m.min) + 1.0f);
+        }
+
+        extend(shortTermPath, shortTermStarted, x, lufsToY(shortTermPoints[i].mean), shortTermPoints[i].mean);
+        extend(truePeakPath, truePeakStarted, x, lufsToY(truePeakPoints[i].max), truePeakPoints[i].max);
+        extend(correlationPath, correlationStarted, x, correlationToY(correlationPoints[i].mean), correlationPoints[i].mean);
+
+        const auto& c = correlationPoints[i];
+        if (!std::isnan(c.mean))
+        {
+            g.setColour(juce::Colours::limegreen.withAlpha(0.3f));
+            g.drawVerticalLine((int)x, correlationToY(c.max), correlationToY(c.min) + 1.0f);
+        }
+    }
+
+    // Target zone (1 LU either side), with the short-term line red wherever it overshoots
+    const float target = loudnessTargetsLufs[juce::jlimit(0, (int)std::size(loudnessTargetsLufs) - 1,
+                                                          loudnessTargetBox.getSelectedItemIndex())];
+    const float targetY = lufsToY(target);
+
+    g.setColour(juce::Colours::yellow.withAlpha(0.12f));
+    g.fillRect(juce::Rectangle<float>((float)loudnessHistoryArea.getX(), lufsToY(target + 1.0f),
+                                      (float)loudnessHistoryArea.getWidth(), lufsToY(target - 1.0f) - lufsToY(target + 1.0f)));
+    g.setColour(juce::Colours::yellow.withAlpha(0.5f));
+    g.drawHorizontalLine((int)targetY, (float)loudnessHistoryArea.getX(), (float)loudnessHistoryArea.getRight());
+
     g.setColour(juce::Colours::white);
-    g.drawText("LUFS screen (WIP)",
-        area.reduced(20),
-        juce::Justification::centredLeft);
+    g.strokePath(shortTermPath, juce::PathStrokeType(1.5f));
+
+    {
+        juce::Graphics::ScopedSaveState state(g);
+        g.reduceClipRegion(loudnessHistoryArea.withBottom((int)targetY));
+        g.setColour(juce::Colours::red);
+        g.strokePath(shortTermPath, juce::PathStrokeType(1.5f));
+    }
+
+    g.setColour(juce::Colours::orange.withAlpha(0.8f));
+    g.strokePath(truePeakPath, juce::PathStrokeType(1.0f));
+
+    g.setColour(juce::Colours::limegreen);
+    g.strokePath(correlationPath, juce::PathStrokeType(1.0f));
+
+    g.setColour(juce::Colours::white.withAlpha(0.5f));
+    g.drawText("short-term (white), momentary range (blue), true peak (orange)",
+               loudnessHistoryArea.reduced(4).removeFromTop(14), juce::Justification::right);
+    g.drawText("correlation", correlationHistoryArea.reduced(4).removeFromTop(14), juce::Justification::right);
 }
 
 void YetAnotherAudioAnalyzerAudioProcessorEditor::drawFrequencyOverlay(juce::Graphics& g, juce::Rectangle<int> area)
@@ -441,10 +1122,25 @@ void YetAnotherAudioAnalyzerAudioProcessorEditor::resized()
     int tabWidth = 120;
     
     spectrumTab.setBounds(header.removeFromLeft(tabWidth));
+    spectrogramTab.setBounds(header.removeFromLeft(tabWidth));
     multibandCorrelationTab.setBounds(header.removeFromLeft(tabWidth));
     stereoTab.setBounds(header.removeFromLeft(tabWidth));
     lufsTab.setBounds(header.removeFromLeft(tabWidth));
 
+    // Spectrum settings and the LUFS controls are never shown together, so
+    // both are laid out from the right edge of what the tabs leave
+    auto spectrumSettings = header;
+    multiResButton.setBounds(spectrumSettings.removeFromRight(90).reduced(6));
+    fftSizeBox.setBounds(spectrumSettings.removeFromRight(90).reduced(6));
+    averagingTimeSlider.setBounds(spectrumSettings.removeFromRight(160).reduced(6));
+    averagingBox.setBounds(spectrumSettings.removeFromRight(110).reduced(6));
+    correlationBandsBox.setBounds(spectrumSettings.removeFromRight(100).reduced(6));
+
+    auto lufsControls = header;
+    resetLoudnessButton.setBounds(lufsControls.removeFromRight(80).reduced(6));
+    historySpanBox.setBounds(lufsControls.removeFromRight(110).reduced(6));
+    loudnessTargetBox.setBounds(lufsControls.removeFromRight(110).reduced(6));
+
     // Footer
     meterFooterArea = bounds.removeFromBottom(meterFooterHeight);
 
@@ -475,9 +1171,62 @@ void YetAnotherAudioAnalyzerAudioProcessorEditor::resized()
         footerLayout.getCentreY() - buttonHeight / 2,
         buttonWidth,
         buttonHeight);
+
+    freezeButton.setBounds(
+        abButton.getRight() + buttonSpacing * 3,
+        footerLayout.getCentreY() - buttonHeight / 2,
+        buttonWidth,
+        buttonHeight);
+
+    snapshotButton.setBounds(
+        freezeButton.getRight() + buttonSpacing,
+        footerLayout.getCentreY() - buttonHeight / 2,
+        buttonWidth + 10,
+        buttonHeight);
+
+    clearSnapshotsButton.setBounds(
+        snapshotButton.getRight() + buttonSpacing,
+        footerLayout.getCentreY() - buttonHeight / 2,
+        buttonWidth,
+        buttonHeight);
+
+    analysisPairBox.setBounds(
+        clearSnapshotsButton.getRight() + buttonSpacing * 3,
+        footerLayout.getCentreY() - buttonHeight / 2,
+        buttonWidth + 40,
+        buttonHeight);
+
+    // Whatever is left of the footer: per-channel true-peak lamps on a surround bus
+    const int lampsX = analysisPairBox.getRight() + buttonSpacing * 3;
+
+    truePeakLampArea = {
+        lampsX,
+        footerLayout.getCentreY() - buttonHeight / 2,
+        juce::jmax(0, footerLayout.getRight() - buttonSpacing - lampsX),
+        buttonHeight };
     
     mainViewArea = bounds.reduced(10); // clean margin
 
+    updateSpectrumDisplayMap();
+    spectrogram.setHeight(mainViewArea.getHeight());
+
+    // Stereo view: square phase cloud on the left, per-frequency traces on the right
+    auto stereoLayout = mainViewArea.reduced(20);
+    goniometerArea = stereoLayout.removeFromLeft(juce::jmin(stereoLayout.getHeight(), stereoLayout.getWidth() / 2));
+    stereoLayout.removeFromLeft(20);
+    stereoSpectrumArea = stereoLayout;
+    stereoSpectrum.setNumColumns(stereoSpectrumArea.getWidth());
+
+    // LUFS view: readouts, then the loudness graph over the correlation lane
+    auto lufsLayout = mainViewArea.reduced(20);
+    lufsReadoutArea = lufsLayout.removeFromTop(180);
+    lufsLayout.removeFromTop(10);
+    correlationHistoryArea = lufsLayout.removeFromBottom(60);
+    lufsLayout.removeFromBottom(10);
+    loudnessHistoryArea = lufsLayout;
+
+    for (auto& points : historyPoints)
+        points.resize((size_t)juce::jmax(0, loudnessHistoryArea.getWidth()));
 
 }
 
@@ -496,33 +1245,6 @@ float YetAnotherAudioAnalyzerAudioProcessorEditor::logX(int bin, int numBins, fl
     return ((logFreq - logMin) / (logMax - logMin)) * width;
 }
 
-float YetAnotherAudioAnalyzerAudioProcessorEditor::xToFrequency(float xNorm) const
-{
-    const float minFreq = 20.0f;
-    const float maxFreq = audioProcessor.getSampleRate() * 0.5f;
-
-    float logMin = std::log10(minFreq);
-    float logMax = std::log10(maxFreq);
-
-    float logFreq = logMin + xNorm * (logMax - logMin);
-    return std::pow(10.0f, logFreq);
-}
-
-float YetAnotherAudioAnalyzerAudioProcessorEditor::interpolateMagnitude(const std::vector<float>& mags, float freq,float sampleRate)
-{
-    if (mags.empty()) return 0.0f;
-
-    const float nyquist = sampleRate * 0.5f;
-    freq = juce::jlimit(0.0f, nyquist, freq);
-
-    float binFloat = (freq / nyquist) * (float)(mags.size() - 1); // -1 because last bin index = size-1
-    int bin0 = juce::jlimit(0, (int)mags.size() - 1, (int)std::floor(binFloat));
-    int bin1 = juce::jmin(bin0 + 1, (int)mags.size() - 1);
-
-    float frac = binFloat - bin0;
-    return juce::jmap(frac, mags[bin0], mags[bin1]);
-}
-
 void YetAnotherAudioAnalyzerAudioProcessorEditor::drawFooterWidth(juce::Graphics& g, juce::Rectangle<int> area)
 {
 
@@ -595,30 +1317,4 @@ void YetAnotherAudioAnalyzerAudioProcessorEditor::drawFooterCorrelation(juce::Gr
         (float)barArea.getBottom());
 }
 
-void YetAnotherAudioAnalyzerAudioProcessorEditor::updateStereoScope(
-    const juce::AudioBuffer<float>& buffer)
-{
-    stereoScopePoints.clear();
-
-    if (buffer.getNumChannels() < 2)
-        return;
-
-    auto* L = buffer.getReadPointer(0);
-    auto* R = buffer.getReadPointer(1);
-    int N = buffer.getNumSamples();
-
-    const int step = 4; // downsample for performance
-
-    for (int i = 0; i < N; i += step)
-    {
-        float l = L[i];
-        float r = R[i];
-
-        float mid = 0.5f * (l + r);
-        float side = 0.5f * (l - r);
-
-        stereoScopePoints.emplace_back(side, mid);
-    }
-}
-
 
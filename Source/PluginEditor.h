@@ -10,6 +10,10 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "DSP/SpectrumDisplayMap.h"
+#include "DSP/SpectrogramImage.h"
+#include "DSP/GoniometerImage.h"
+#include "DSP/StereoSpectrum.h"
 #include <juce_core/juce_core.h>
 #include <iostream>
 
@@ -17,7 +21,18 @@
 /**
 */
 
-enum class ViewMode { Spectrum, MultibandCorrelation, StereoWidth, AdvanceLufs };
+enum class ViewMode { Spectrum, Spectrogram, MultibandCorrelation, StereoWidth, AdvanceLufs };
+
+// One frame from every analyzer. Holding it pins the frames, nothing is copied.
+struct AnalysisSnapshot
+{
+    SpectrumAnalyzer::FramePtr spectrum;
+    CorrelationMeter::FramePtr correlation;
+    MultibandCorrelationMeter::FramePtr multiband;
+    LevelMeter::FramePtr level;
+    TruePeakMeter::FramePtr truePeak;
+    StereoWidthVisualizer::FramePtr width;
+};
 
 class YetAnotherAudioAnalyzerAudioProcessorEditor  : public juce::AudioProcessorEditor, private juce::Timer
 {
@@ -30,6 +45,7 @@ public:
     //==============================================================================
     void paint (juce::Graphics&) override;
     void resized() override;
+    void mouseDown(const juce::MouseEvent& event) override;
     void paintViewHeader(juce::Graphics& g);
     void paintMainView(juce::Graphics& g);
     void paintMeterFooter(juce::Graphics& g);
@@ -37,23 +53,32 @@ public:
     void paintSpectrumScreen(juce::Graphics&, juce::Rectangle<int> area);
     void drawFrequencyOverlay(juce::Graphics& g, juce::Rectangle<int> area);
 
+    void paintSpectrogramScreen(juce::Graphics&, juce::Rectangle<int> area);
+
     void paintMultibandScreen(juce::Graphics&, juce::Rectangle<int> area);
     void paintStereoWidthScreen(juce::Graphics&, juce::Rectangle<int> area);
-    void paintLufsScreen(juce::Graphics&, juce::Rectangle<int> area);
+    // Lays itself out in the areas resized() keeps for the history points
+    void paintLufsScreen(juce::Graphics&);
 
 
 private:
     void timerCallback();
+    void updateLiveSnapshot();
+    void takeSnapshot();
+    void drawSpectrumSnapshots(juce::Graphics& g, juce::Rectangle<int> area);
+    void updateSpectrumDisplayMap();
     float logX(int bin, int numBins, float width, float sampleRate);
-    float xToFrequency(float xNorm) const;
-    float interpolateMagnitude(const std::vector<float>& mags, float freq, float sampleRate);
     void drawFooterWidth(juce::Graphics& g, juce::Rectangle<int> area);
     void drawFooterCorrelation(juce::Graphics& g, juce::Rectangle<int> area);
-    void updateStereoScope(const juce::AudioBuffer<float>& buffer);
+    void updateHistoryPoints();
+    void updateRecentEvents();
+    static juce::String getChannelName(const juce::AudioChannelSet& layout, int channel);
+    static juce::String describeEvent(const MeterEvent& event, double sampleRate, const juce::AudioChannelSet& layout);
+    static juce::uint32 getAnalyzersShownIn(ViewMode view, bool multiResolution);
+    void drawLoudnessHistory(juce::Graphics& g);
     YetAnotherAudioAnalyzerAudioProcessor& audioProcessor;
 
     // Basic values from meters
-    std::vector<float> leftMagnitudes, rightMagnitudes;
     float levelValue = 0.0f;
     float correlationValue = 1.0f;
     float widthValue = 0.5f;
@@ -65,20 +90,99 @@ private:
 
     ViewMode currentView = ViewMode::Spectrum;
 
+    // The optional analyzers the current view reads; the rest are paused
+    // while this editor is the only consumer, and closing it releases all of them
+    AnalyzerRegistry::Consumer analyzerDemand{ audioProcessor.getAnalyzerRegistry(),
+                                               getAnalyzersShownIn(currentView, audioProcessor.isMultiResolutionEnabled()) };
+
+    // Column -> bin table for the spectrum line plus per-column state, sized with mainViewArea
+    SpectrumDisplayMap spectrumDisplayMap;
+    std::vector<float> spectrumColumnsL, spectrumColumnsR;
+    std::vector<float> spectrumColumnState;
+
+    // What the views show: refreshed every tick unless frozen
+    AnalysisSnapshot live;
+    bool frozen = false;
+
+    // Pinned frames overlaid on the spectrum, each with its own map since the
+    // FFT size may have changed since it was taken. Only the spectrum,
+    // correlation and level frames are held; the others stay null.
+    struct SpectrumSnapshot
+    {
+        AnalysisSnapshot frames;
+        SpectrumDisplayMap displayMap;
+    };
+
+    static constexpr int maxSnapshots = AnalysisFramePool<SpectrumAnalyzer::Frame>::maxPinnedFrames;
+    std::vector<SpectrumSnapshot> snapshots;
+    std::vector<float> snapshotColumnsL, snapshotColumnsR;
+
+    // Scrolls whenever the spectrum analyzer runs (spectrum view without
+    // Multi-Res, spectrogram and stereo views), and stops with the others
+    SpectrogramImage spectrogram;
+    std::vector<float> spectrogramInput;
+
+    // Phase cloud for the stereo view, fed from the processor's scope tap
+    GoniometerImage goniometer;
+
+    // Width / correlation / balance per frequency, next to the phase cloud
+    StereoSpectrum stereoSpectrum;
+    juce::Rectangle<int> goniometerArea;
+    juce::Rectangle<int> stereoSpectrumArea;
+
+    // LUFS view: readouts above a loudness graph and a correlation lane, one
+    // history point per pixel column
+    juce::Rectangle<int> lufsReadoutArea;
+    juce::Rectangle<int> loudnessHistoryArea;
+    juce::Rectangle<int> correlationHistoryArea;
+    std::vector<MeterHistory::Point> historyPoints[MeterHistory::numSeries];
+
+    // Newest last; copied from the processor's event log every tick, frozen or not
+    static constexpr int maxRecentEvents = 6;
+    std::vector<MeterEvent> recentEvents;
+
     juce::Rectangle<int> mainViewArea;
     juce::Rectangle<int> meterFooterArea;
     juce::Rectangle<int> levelMeterArea;
     juce::Rectangle<int> stereoFooterArea;
+    juce::Rectangle<int> truePeakLampArea;    // only drawn with more than two channels
 
     juce::TextButton multibandCorrelationTab { "Multiband Correlation" };
     juce::TextButton spectrumTab{ "Spectrum" };
+    juce::TextButton spectrogramTab{ "Spectrogram" };
     juce::TextButton stereoTab{ "Stereo" };
     juce::TextButton lufsTab{ "LUFS" };
 
+    juce::TextButton multiResButton{ "Multi-Res" };
+
+    juce::ComboBox fftSizeBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> fftSizeAttachment;
+
+    juce::ComboBox averagingBox;
+    juce::Slider averagingTimeSlider{ juce::Slider::LinearHorizontal, juce::Slider::TextBoxRight };
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> averagingAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> averagingTimeAttachment;
+
+    // Only shown with the multiband view
+    juce::ComboBox correlationBandsBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> correlationBandsAttachment;
+
+    // Only shown with the LUFS view: restarts integrated, LRA and true-peak max
+    juce::TextButton resetLoudnessButton{ "Reset" };
+    juce::ComboBox historySpanBox;
+    juce::ComboBox loudnessTargetBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> loudnessTargetAttachment;
+
+    // Which channels of a surround bus the spectrum, stereo and multiband views analyse
+    juce::ComboBox analysisPairBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> analysisPairAttachment;
+
     juce::TextButton monoButton{ "Mono" };
     juce::TextButton abButton{ "A/B" };
 
-    std::vector<juce::Point<float>> stereoScopePoints;
+    juce::TextButton freezeButton{ "Freeze" };
+    juce::TextButton snapshotButton{ "Snapshot" };
+    juce::TextButton clearSnapshotsButton{ "Clear" };
 
     float smoothedLeft = 0.0f;
     float smoothedRight = 0.0f;
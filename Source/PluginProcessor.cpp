@@ -9,6 +9,59 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+// Upper end of the averaging time; also what the sliding window preallocates for
+static constexpr float maxAveragingSeconds = 10.0f;
+
+// Upper end of the correlation meter's integration time, which sizes its window
+static constexpr float maxCorrelationMs = 1000.0f;
+
+// Channel types behind analysisPairNames. Each side lists the types it may go
+// by (5.1 and quad call the surrounds leftSurround, 7.1 leftSurroundSide).
+struct AnalysisPairTypes
+{
+    juce::AudioChannelSet::ChannelType first[2];
+    juce::AudioChannelSet::ChannelType second[2];
+};
+
+static constexpr AnalysisPairTypes analysisPairTypes[] =
+{
+    { { juce::AudioChannelSet::left, juce::AudioChannelSet::unknown },                 { juce::AudioChannelSet::right, juce::AudioChannelSet::unknown } },
+    { { juce::AudioChannelSet::centre, juce::AudioChannelSet::unknown },               { juce::AudioChannelSet::unknown, juce::AudioChannelSet::unknown } },
+    { { juce::AudioChannelSet::leftSurround, juce::AudioChannelSet::leftSurroundSide }, { juce::AudioChannelSet::rightSurround, juce::AudioChannelSet::rightSurroundSide } },
+    { { juce::AudioChannelSet::leftSurroundRear, juce::AudioChannelSet::unknown },     { juce::AudioChannelSet::rightSurroundRear, juce::AudioChannelSet::unknown } },
+    { { juce::AudioChannelSet::topFrontLeft, juce::AudioChannelSet::unknown },         { juce::AudioChannelSet::topFrontRight, juce::AudioChannelSet::unknown } },
+    { { juce::AudioChannelSet::topRearLeft, juce::AudioChannelSet::unknown },          { juce::AudioChannelSet::topRearRight, juce::AudioChannelSet::unknown } }
+};
+
+static_assert(std::size(analysisPairTypes) == std::size(analysisPairNames), "one entry per analysis pair");
+
+static int findChannel(const juce::AudioChannelSet& layout, const juce::AudioChannelSet::ChannelType (&types)[2])
+{
+    for (auto type : types)
+        if (type != juce::AudioChannelSet::unknown)
+            if (const int index = layout.getChannelIndexForType(type); index >= 0)
+                return index;
+
+    return -1;
+}
+
+// Bus layouts from mono up to 7.1.4, the same on input and output
+static bool isSupportedLayout(const juce::AudioChannelSet& set)
+{
+    const juce::AudioChannelSet supported[] =
+    {
+        juce::AudioChannelSet::mono(),          juce::AudioChannelSet::stereo(),
+        juce::AudioChannelSet::createLCR(),     juce::AudioChannelSet::quadraphonic(),
+        juce::AudioChannelSet::create5point0(), juce::AudioChannelSet::create5point1(),
+        juce::AudioChannelSet::create6point0(), juce::AudioChannelSet::create6point1(),
+        juce::AudioChannelSet::create7point0(), juce::AudioChannelSet::create7point1(),
+        juce::AudioChannelSet::create7point0point2(), juce::AudioChannelSet::create7point1point2(),
+        juce::AudioChannelSet::create7point0point4(), juce::AudioChannelSet::create7point1point4()
+    };
+
+    return std::find(std::begin(supported), std::end(supported), set) != std::end(supported);
+}
+
 //==============================================================================
 YetAnotherAudioAnalyzerAudioProcessor::YetAnotherAudioAnalyzerAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -19,13 +72,87 @@ YetAnotherAudioAnalyzerAudioProcessor::YetAnotherAudioAnalyzerAudioProcessor()
                       #endif
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
                      #endif
-                       )
+                       ),
+#else
+     :
 #endif
+      parameters (*this, nullptr, "Parameters", createParameterLayout())
 {
+    fftSizeParameter = parameters.getRawParameterValue(ParameterIDs::fftSize);
+    averagingModeParameter = parameters.getRawParameterValue(ParameterIDs::averagingMode);
+    averagingTimeParameter = parameters.getRawParameterValue(ParameterIDs::averagingTime);
+    correlationTimeParameter = parameters.getRawParameterValue(ParameterIDs::correlationTime);
+    correlationBandsParameter = parameters.getRawParameterValue(ParameterIDs::correlationBands);
+    widthWindowParameter = parameters.getRawParameterValue(ParameterIDs::widthWindow);
+    loudnessTargetParameter = parameters.getRawParameterValue(ParameterIDs::loudnessTarget);
+    analysisPairParameter = parameters.getRawParameterValue(ParameterIDs::analysisPair);
+
+    spectrumAnalyzer.setMaxAveragingTime(maxAveragingSeconds);
+
+    // The editor asks for frames at its own rate; no transforms nobody looks at
+    spectrumAnalyzer.setScheduling(SpectrumAnalyzer::Scheduling::onDemand);
+
+    // Every view of the main spectrum ends up in dB, so skip the per-bin sqrt
+    spectrumAnalyzer.setMagnitudeScale(SpectrumAnalyzer::MagnitudeScale::power);
+
+    analysisWorker.addClient(&spectrumAnalyzer);
+    analysisWorker.addClient(&multiResolutionSpectrum);
+    analysisWorker.addClient(&multibandCorrelationMeter);
+    analysisWorker.addClient(&meterHistory);
+    analysisWorker.addClient(&meterEventLog);
+
+    levelMeter.setEventLog(&meterEventLog);
+    truePeakMeter.setEventLog(&meterEventLog);
+    correlationMeter.setEventLog(&meterEventLog);
 }
 
 YetAnotherAudioAnalyzerAudioProcessor::~YetAnotherAudioAnalyzerAudioProcessor()
 {
+    analysisWorker.stop();
+}
+
+juce::AudioProcessorValueTreeState::ParameterLayout YetAnotherAudioAnalyzerAudioProcessor::createParameterLayout()
+{
+    juce::AudioProcessorValueTreeState::ParameterLayout layout;
+
+    juce::StringArray fftSizes;
+    for (int order = SpectrumAnalyzer::minFFTOrder; order <= SpectrumAnalyzer::maxFFTOrder; ++order)
+        fftSizes.add(juce::String(1 << order));
+
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { ParameterIDs::fftSize, 1 }, "FFT Size",
+                                                            fftSizes, 14 - SpectrumAnalyzer::minFFTOrder));
+
+    // Choice order follows SpectrumAnalyzer::AveragingMode
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { ParameterIDs::averagingMode, 1 }, "Averaging",
+                                                            juce::StringArray { "Instantaneous", "Exponential", "Sliding Window" }, 0));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::averagingTime, 1 }, "Averaging Time",
+                                                           juce::NormalisableRange<float> { 0.1f, maxAveragingSeconds, 0.01f, 0.4f }, 1.0f));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::correlationTime, 1 }, "Correlation Time",
+                                                           juce::NormalisableRange<float> { 10.0f, maxCorrelationMs, 1.0f, 0.5f }, 300.0f));
+
+    juce::StringArray bandCounts;
+    for (int bands = MultibandCorrelationMeter::minBands; bands <= MultibandCorrelationMeter::maxBands; ++bands)
+        bandCounts.add(juce::String(bands));
+
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { ParameterIDs::correlationBands, 1 }, "Correlation Bands",
+                                                            bandCounts, 6 - MultibandCorrelationMeter::minBands));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { ParameterIDs::widthWindow, 1 }, "Width Window",
+                                                           juce::NormalisableRange<float> { 10.0f, 1000.0f, 1.0f, 0.5f }, 100.0f));
+
+    juce::StringArray targets;
+    for (auto lufs : loudnessTargetsLufs)
+        targets.add(juce::String((int)lufs) + " LUFS");
+
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { ParameterIDs::loudnessTarget, 1 }, "Loudness Target",
+                                                            targets, 2));
+
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { ParameterIDs::analysisPair, 1 }, "Analysis Pair",
+                                                            juce::StringArray(analysisPairNames, (int)std::size(analysisPairNames)), 0));
+
+    return layout;
 }
 
 //==============================================================================
@@ -90,18 +217,48 @@ void YetAnotherAudioAnalyzerAudioProcessor::changeProgramName (int index, const
 //==============================================================================
 void YetAnotherAudioAnalyzerAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    spectrumAnalyzerL.prepareToPlay(sampleRate, samplesPerBlock);
-    spectrumAnalyzerR.prepareToPlay(sampleRate, samplesPerBlock);
-    levelMeter.prepare(sampleRate, getTotalNumInputChannels());
+    // analyzers are reset below, so keep the worker away from them meanwhile
+    analysisWorker.stop();
+
+    const auto busLayout = getChannelLayoutOfBus(true, 0);
+
+    for (size_t pair = 0; pair < std::size(analysisPairTypes); ++pair)
+    {
+        auto& channels = analysisPairChannels[pair];
+        channels[0] = findChannel(busLayout, analysisPairTypes[pair].first);
+        channels[1] = findChannel(busLayout, analysisPairTypes[pair].second);
+
+        if (channels[0] < 0)
+        {
+            channels[0] = busLayout.size() > 0 ? 0 : -1;
+            channels[1] = busLayout.size() > 1 ? 1 : -1;
+        }
+    }
+
+    spectrumAnalyzer.prepareToPlay(sampleRate, samplesPerBlock);
+    multiResolutionSpectrum.prepareToPlay(sampleRate, samplesPerBlock);
+    levelMeter.prepare(sampleRate, busLayout);
+    truePeakMeter.prepare(busLayout.size());
     
-    correlationMeter.prepareToPlay(1024);
+    correlationMeter.setIntegrationTime(correlationTimeParameter->load());
+    correlationMeter.prepareToPlay(sampleRate, maxCorrelationMs);
+
+    multibandCorrelationMeter.setIntegrationTime(correlationTimeParameter->load());
+    multibandCorrelationMeter.setNumBands(MultibandCorrelationMeter::minBands + (int)correlationBandsParameter->load());
+    multibandCorrelationMeter.prepareToPlay(sampleRate, samplesPerBlock);
+    stereoWidthMeter.setWindowTime(widthWindowParameter->load());
     stereoWidthMeter.prepare(sampleRate, samplesPerBlock);
+    stereoScopeTap.prepare(sampleRate);
+    meterHistory.prepare(sampleRate, samplesPerBlock);
+    meterEventLog.prepare(sampleRate);
+    samplesSincePrepare = 0;
 
+    analysisWorker.start();
 }
 
 void YetAnotherAudioAnalyzerAudioProcessor::releaseResources()
 {
-    // Nothing to release for analyzers
+    analysisWorker.stop();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -111,12 +268,9 @@ bool YetAnotherAudioAnalyzerAudioProcessor::isBusesLayoutSupported (const BusesL
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Anything from mono up to 7.1.4. Some plugin hosts, such as certain
+    // GarageBand versions, will only load plugins that support stereo bus layouts.
+    if (!isSupportedLayout(layouts.getMainOutputChannelSet()))
         return false;
 
     // This checks if the input layout matches the output layout
@@ -136,21 +290,81 @@ void YetAnotherAudioAnalyzerAudioProcessor::processBlock (juce::AudioBuffer<floa
 
     const int numSamples = buffer.getNumSamples();
 
-    // Guard channels
-    const float* left = (buffer.getNumChannels() > 0) ? buffer.getReadPointer(0) : nullptr;
-    const float* right = (buffer.getNumChannels() > 1) ? buffer.getReadPointer(1) : nullptr;
+    // Just an atomic store; the worker switches plans at the next hop
+    spectrumAnalyzer.setFFTOrder(SpectrumAnalyzer::minFFTOrder + (int)fftSizeParameter->load(std::memory_order_relaxed));
+    spectrumAnalyzer.setAveraging((SpectrumAnalyzer::AveragingMode)(int)averagingModeParameter->load(std::memory_order_relaxed),
+                                  averagingTimeParameter->load(std::memory_order_relaxed));
+    correlationMeter.setIntegrationTime(correlationTimeParameter->load(std::memory_order_relaxed));
+    multibandCorrelationMeter.setIntegrationTime(correlationTimeParameter->load(std::memory_order_relaxed));
+    multibandCorrelationMeter.setNumBands(MultibandCorrelationMeter::minBands + (int)correlationBandsParameter->load(std::memory_order_relaxed));
+    stereoWidthMeter.setWindowTime(widthWindowParameter->load(std::memory_order_relaxed));
+    // Only what some view or export is reading runs; the meters below the
+    // spectrum (level, true peak, correlation, history, events) always do
+    spectrumAnalyzer.setActive(analyzerRegistry.isActive(AnalyzerRegistry::spectrum));
+    multiResolutionSpectrum.setActive(analyzerRegistry.isActive(AnalyzerRegistry::multiResolutionSpectrum));
+    multibandCorrelationMeter.setActive(analyzerRegistry.isActive(AnalyzerRegistry::multibandCorrelation));
+    stereoScopeTap.setActive(analyzerRegistry.isActive(AnalyzerRegistry::stereoScope));
+    levelMeter.setLoudnessTarget(loudnessTargetsLufs[juce::jlimit(0, (int)std::size(loudnessTargetsLufs) - 1,
+                                                                  (int)loudnessTargetParameter->load(std::memory_order_relaxed))]);
+
+    // Events from the meters below are stamped relative to this block
+    juce::AudioPlayHead::PositionInfo hostPosition;
+    bool hasHostPosition = false;
+
+    if (auto* playHead = getPlayHead())
+    {
+        if (const auto position = playHead->getPosition())
+        {
+            hostPosition = *position;
+            hasHostPosition = true;
+        }
+    }
+
+    meterEventLog.beginBlock(samplesSincePrepare, hasHostPosition ? &hostPosition : nullptr);
+    samplesSincePrepare += numSamples;
+
+    // The selected pair; a missing channel reads as nullptr like on a mono bus
+    const auto& pair = analysisPairChannels[juce::jlimit(0, (int)std::size(analysisPairNames) - 1,
+                                                         (int)analysisPairParameter->load(std::memory_order_relaxed))];
+    auto channelOrNull = [&buffer](int channel) { return juce::isPositiveAndBelow(channel, buffer.getNumChannels()) ? buffer.getReadPointer(channel) : nullptr; };
+
+    const float* left = channelOrNull(pair[0]);
+    const float* right = channelOrNull(pair[1]);
+
+    // The one pass over the pair that the level, correlation and width meters
+    // share; with both channels it also writes the correlation window
+    StereoKernels::Sums blockSums;
+    if (left != nullptr && right != nullptr)
+        blockSums = correlationMeter.pushAudioBlock(left, right, numSamples);
+    else if (left != nullptr)
+        blockSums = StereoKernels::measure(left, left, numSamples);
+
+    // mono input feeds the same signal to both halves of the stereo FFT
+    if (left != nullptr)
+    {
+        spectrumAnalyzer.pushAudioBlock(left, right != nullptr ? right : left, numSamples);
+
+        if (multiResolutionEnabled.load(std::memory_order_relaxed))
+            multiResolutionSpectrum.pushAudioBlock(left, right != nullptr ? right : left, numSamples);
+    }
+
+    multibandCorrelationMeter.pushAudioBlock(left, right, numSamples);
+
+    // Loudness and true peak over every channel of the bus; the level bars show the pair
+    levelMeter.processBuffer(buffer, 0, numSamples, blockSums);
+    truePeakMeter.pushAudioBlock(buffer.getArrayOfReadPointers(), buffer.getNumChannels(), numSamples);
+    stereoWidthMeter.processBlock(left, right, numSamples, blockSums);
 
     if (left != nullptr)
-        spectrumAnalyzerL.pushAudioBlock(left, numSamples);
-    if (right != nullptr)
-        spectrumAnalyzerR.pushAudioBlock(right, numSamples);
+        stereoScopeTap.pushAudioBlock(left, right != nullptr ? right : left, numSamples);
 
-    // correlation/stereo width (you already have working code)
-    correlationMeter.pushAudioBlock(left, right, numSamples);
+    // Without a second channel the correlation meter didn't run; record a gap
+    // rather than its last value
+    const float correlation = right != nullptr ? correlationMeter.getCorrelation()
+                                               : std::numeric_limits<float>::quiet_NaN();
 
-    // Level meter: pass the entire buffer range explicitly
-    levelMeter.processBuffer(buffer, 0, numSamples);
-    stereoWidthMeter.processBlock(buffer);
+    meterHistory.pushBlock(numSamples, { levelMeter.getMomentaryLufs(), levelMeter.getShortTermLufs(),
+                                         truePeakMeter.getBlockPeakDb(), correlation });
 }
 
 //==============================================================================
@@ -167,13 +381,15 @@ juce::AudioProcessorEditor* YetAnotherAudioAnalyzerAudioProcessor::createEditor(
 //==============================================================================
 void YetAnotherAudioAnalyzerAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    juce::ignoreUnused(destData);
-    // No parameters yet — implement later if needed
+    if (auto xml = parameters.copyState().createXml())
+        copyXmlToBinary(*xml, destData);
 }
 
 void YetAnotherAudioAnalyzerAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    juce::ignoreUnused(data, sizeInBytes);
+    if (auto xml = getXmlFromBinary(data, sizeInBytes))
+        if (xml->hasTagName(parameters.state.getType()))
+            parameters.replaceState(juce::ValueTree::fromXml(*xml));
 }
 
 //==============================================================================
@@ -10,9 +10,37 @@
 
 #include <JuceHeader.h>
 #include "DSP/SpectrumAnalyzer.h"
+#include "DSP/MultiResolutionSpectrumAnalyzer.h"
 #include "DSP/CorrelationMeter.h"
+#include "DSP/MultibandCorrelationMeter.h"
 #include "DSP/LevelMeter.h"
+#include "DSP/TruePeakMeter.h"
 #include "DSP/StereoWidthVisualizer.h"
+#include "DSP/StereoScopeTap.h"
+#include "DSP/MeterHistory.h"
+#include "DSP/MeterEventLog.h"
+#include "DSP/AnalyzerRegistry.h"
+#include "DSP/AnalysisWorker.h"
+
+namespace ParameterIDs
+{
+    inline constexpr const char* fftSize = "fftSize"; // choice index, 0 = 2^SpectrumAnalyzer::minFFTOrder
+    inline constexpr const char* averagingMode = "averagingMode"; // SpectrumAnalyzer::AveragingMode
+    inline constexpr const char* averagingTime = "averagingTime"; // seconds
+    inline constexpr const char* correlationTime = "correlationTime"; // milliseconds
+    inline constexpr const char* correlationBands = "correlationBands"; // choice index, 0 = MultibandCorrelationMeter::minBands
+    inline constexpr const char* widthWindow = "widthWindow"; // milliseconds
+    inline constexpr const char* loudnessTarget = "loudnessTarget"; // choice index into loudnessTargetsLufs
+    inline constexpr const char* analysisPair = "analysisPair"; // choice index into analysisPairNames
+}
+
+// Delivery targets for short-term loudness: EBU R128, then common streaming ones
+inline constexpr float loudnessTargetsLufs[] = { -23.0f, -16.0f, -14.0f, -13.0f };
+
+// Channels the spectrum, correlation, width and scope analyse. Loudness and
+// true peak always cover the whole bus. A pair the bus doesn't have falls
+// back to its first two channels.
+inline constexpr const char* analysisPairNames[] = { "L / R", "C", "Ls / Rs", "Lrs / Rrs", "Ltf / Rtf", "Ltr / Rtr" };
 
 //==============================================================================
 /**
@@ -57,20 +85,60 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
     
+    juce::AudioProcessorValueTreeState& getParameters() { return parameters; }
+
     // ====== DSP Getters for Editor ======
-    SpectrumAnalyzer& getSpectrumAnalyzerL() { return spectrumAnalyzerL; }
-    SpectrumAnalyzer& getSpectrumAnalyzerR() { return spectrumAnalyzerR; }
+    SpectrumAnalyzer& getSpectrumAnalyzer() { return spectrumAnalyzer; }
+    MultiResolutionSpectrumAnalyzer& getMultiResolutionSpectrum() { return multiResolutionSpectrum; }
+    void setMultiResolutionEnabled(bool enabled) { multiResolutionEnabled.store(enabled); }
+    bool isMultiResolutionEnabled() const { return multiResolutionEnabled.load(); }
     CorrelationMeter& getCorrelationMeter() { return correlationMeter; }
+    MultibandCorrelationMeter& getMultibandCorrelationMeter() { return multibandCorrelationMeter; }
     LevelMeter& getLevelMeter() { return levelMeter; }
+    TruePeakMeter& getTruePeakMeter() { return truePeakMeter; }
     StereoWidthVisualizer& getStereoWidthMeter() { return stereoWidthMeter; }
+    StereoScopeTap& getStereoScopeTap() { return stereoScopeTap; }
+    const MeterHistory& getMeterHistory() const { return meterHistory; }
+    MeterEventLog& getMeterEventLog() { return meterEventLog; }
+
+    // Views and exports declare here which optional analyzers they read
+    AnalyzerRegistry& getAnalyzerRegistry() { return analyzerRegistry; }
 private:
+    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+
+    juce::AudioProcessorValueTreeState parameters;
+    std::atomic<float>* fftSizeParameter = nullptr;
+    std::atomic<float>* averagingModeParameter = nullptr;
+    std::atomic<float>* averagingTimeParameter = nullptr;
+    std::atomic<float>* correlationTimeParameter = nullptr;
+    std::atomic<float>* correlationBandsParameter = nullptr;
+    std::atomic<float>* widthWindowParameter = nullptr;
+    std::atomic<float>* loudnessTargetParameter = nullptr;
+    std::atomic<float>* analysisPairParameter = nullptr;
+
+    // Bus channel of each side of every analysis pair for the current layout,
+    // -1 for none (the pair is then analysed as mono). Set in prepareToPlay.
+    int analysisPairChannels[std::size(analysisPairNames)][2] = {};
+
     //==============================================================================
-    SpectrumAnalyzer spectrumAnalyzerL;
-    SpectrumAnalyzer spectrumAnalyzerR;
+    // L/R packed into one complex FFT, resolution switchable between 1024 and 65536 points
+    SpectrumAnalyzer spectrumAnalyzer { 14, 2, SpectrumAnalyzer::minFFTOrder, SpectrumAnalyzer::maxFFTOrder };
+    MultiResolutionSpectrumAnalyzer multiResolutionSpectrum;
+    std::atomic<bool> multiResolutionEnabled { false };
     CorrelationMeter correlationMeter;
+    MultibandCorrelationMeter multibandCorrelationMeter;
     LevelMeter levelMeter;
+    TruePeakMeter truePeakMeter;
     StereoWidthVisualizer stereoWidthMeter;
+    StereoScopeTap stereoScopeTap;
+    MeterHistory meterHistory;
+    MeterEventLog meterEventLog;
+    juce::int64 samplesSincePrepare = 0;
+    AnalyzerRegistry analyzerRegistry;
 
+    // Runs the spectrum FFTs off the audio thread. Declared after the analyzers
+    // so it is stopped before any of its clients are destroyed.
+    AnalysisWorker analysisWorker;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(YetAnotherAudioAnalyzerAudioProcessor)
 };
\ No newline at end of file